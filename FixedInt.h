@@ -0,0 +1,340 @@
+#ifndef FIXED_INT_H
+#define FIXED_INT_H
+
+#include "LargeInt.h"
+
+
+
+
+/* LI_UNROLL
+asks the compiler to unroll the following loop; FixedInt loops all have
+compile time trip counts, so up to 1024 bits (16 64 bit digits) they are
+unrolled completely
+*/
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#define LI_UNROLL _Pragma( "GCC unroll 16" )
+#elif defined( __clang__ )
+#define LI_UNROLL _Pragma( "unroll 16" )
+#else
+#define LI_UNROLL
+#endif
+
+
+/* overflow policies
+FixedIntWrapping: results are taken modulo 2^Bits (like unsigned integers)
+FixedIntChecked: any result that does not fit throws std::overflow_error
+   (so checked arithmetic cannot be used in constant expressions that
+   overflow)
+*/
+struct FixedIntWrapping
+{
+    static const bool CHECKED = false;
+};
+
+struct FixedIntChecked
+{
+    static const bool CHECKED = true;
+};
+
+
+/* FixedInt
+unsigned integer of exactly Bits bits (a multiple of the digit size), kept
+in digits on the stack; the same digit layout as LargeInt (lower is less
+significant), so converting between them copies the digits directly
+
+every operation is constexpr, with loops over the compile time digit count
+(no sizes to check, no allocation):
+   constexpr FixedInt<256> value = FixedInt<256>( 3 ) * FixedInt<256>( 5 );
+for anything more (division, strings), convert to a LargeInt
+*/
+template <unsigned int Bits, class OverflowPolicy = FixedIntWrapping>
+class FixedInt
+{
+public:
+    static const unsigned int DIGITS = Bits / LI_Properties::digit::SIZE;
+
+    static_assert( Bits > 0 && Bits % LI_Properties::digit::SIZE == 0,
+                   "FixedInt bits must be a positive multiple of the digit size" );
+
+private:
+    // digits (lower is less significant)
+    LI_Properties::digit::type digits[ DIGITS ];
+
+    // throws with the name of the operation if the policy is checked
+    static constexpr void overflowed( bool overflow, const char *where )
+    {
+        if( OverflowPolicy::CHECKED && overflow )
+        {
+            throw std::overflow_error( std::string( "FixedInt overflow in " ) +
+                                       where + "\n" );
+        }
+    }
+
+public:
+    ////////////////////////// constructors ///////////////////////////////////
+    constexpr FixedInt() : digits() {}
+
+    constexpr FixedInt( LI_Properties::digit::type source ) : digits()
+    {
+        digits[ 0 ] = source;
+    }
+
+    // from the magnitude of a LargeInt (a negative value is stored as its
+    // two's complement when wrapping)
+    explicit FixedInt( const LargeInt &source ) : digits()
+    {
+        overflowed( source.size > DIGITS || source.sign,
+                    "FixedInt::FixedInt( const LargeInt & )" );
+        copyArray( source.digits, digits, min( source.size, DIGITS ) );
+        if( source.sign )
+        {
+            *this = FixedInt() - *this;
+        }
+    }
+
+    explicit operator LargeInt() const
+    {
+        LargeInt result;
+
+        result.resize( DIGITS );
+        copyArray( digits, result.digits, DIGITS );
+        result.removeLeadingZeros();
+        return result;
+    }
+
+    // data access
+    constexpr LI_Properties::digit::type digit( unsigned int index ) const
+    {
+        return digits[ index ];
+    }
+    constexpr void setDigit( unsigned int index, LI_Properties::digit::type value )
+    {
+        digits[ index ] = value;
+    }
+
+    constexpr bool isZero() const
+    {
+        LI_Properties::digit::type any = 0;
+        unsigned int index = 0;
+
+        LI_UNROLL
+        for( index = 0; index < DIGITS; index++ )
+        {
+            any |= digits[ index ];
+        }
+        return any == 0;
+    }
+
+    std::string toString( unsigned int base = 10 ) const
+    {
+        return ( (LargeInt)*this ).toString( base );
+    }
+
+    ////////////////////////// operators //////////////////////////////////////
+    constexpr FixedInt &operator+=( const FixedInt &other )
+    {
+        LI_Properties::digit::doubleSize::type sum = 0;
+        unsigned int index = 0;
+
+        LI_UNROLL
+        for( index = 0; index < DIGITS; index++ )
+        {
+            sum += (LI_Properties::digit::doubleSize::type)digits[ index ] +
+                   other.digits[ index ];
+            digits[ index ] = (LI_Properties::digit::type)sum;
+            sum >>= LI_Properties::digit::SIZE;
+        }
+
+        overflowed( sum != 0, "FixedInt::operator+=" );
+        return *this;
+    }
+
+    constexpr FixedInt &operator-=( const FixedInt &other )
+    {
+        LI_Properties::digit::doubleSize::type difference = 0;
+        LI_Properties::digit::type owe = 0;
+        unsigned int index = 0;
+
+        LI_UNROLL
+        for( index = 0; index < DIGITS; index++ )
+        {
+            difference = (LI_Properties::digit::doubleSize::type)digits[ index ] -
+                         other.digits[ index ] - owe;
+            digits[ index ] = (LI_Properties::digit::type)difference;
+            owe = ( difference >> LI_Properties::digit::SIZE ) != 0;
+        }
+
+        overflowed( owe != 0, "FixedInt::operator-=" );
+        return *this;
+    }
+
+    // product of the low digits; rows are cut off at DIGITS unless checked
+    constexpr FixedInt &operator*=( const FixedInt &other )
+    {
+        LI_Properties::digit::type result[ DIGITS ] = {};
+        LI_Properties::digit::doubleSize::type product = 0;
+        bool overflow = false;
+        unsigned int row = 0, index = 0;
+
+        for( row = 0; row < DIGITS; row++ )
+        {
+            if( digits[ row ] == 0 )
+            {
+                continue;
+            }
+
+            // (max product + 2 max digits still fits in double size)
+            product = 0;
+            LI_UNROLL
+            for( index = 0; index + row < DIGITS; index++ )
+            {
+                product += (LI_Properties::digit::doubleSize::type)digits[ row ] *
+                           other.digits[ index ] + result[ row + index ];
+                result[ row + index ] = (LI_Properties::digit::type)product;
+                product >>= LI_Properties::digit::SIZE;
+            }
+
+            // anything left in the row is past the top digit
+            if( OverflowPolicy::CHECKED )
+            {
+                overflow = overflow || product != 0;
+                for( ; index < DIGITS; index++ )
+                {
+                    overflow = overflow || other.digits[ index ] != 0;
+                }
+            }
+        }
+
+        overflowed( overflow, "FixedInt::operator*=" );
+        copyDigits( result );
+        return *this;
+    }
+
+    constexpr FixedInt &operator<<=( unsigned int shiftBits )
+    {
+        unsigned int digitShift = shiftBits / LI_Properties::digit::SIZE;
+        unsigned int bitShift = shiftBits % LI_Properties::digit::SIZE;
+        LI_Properties::digit::type result[ DIGITS ] = {};
+        LI_Properties::digit::type lost = 0;
+        unsigned int index = 0;
+
+        if( OverflowPolicy::CHECKED )
+        {
+            lost = shiftBits >= Bits ? !isZero() :
+                   ( *this >> ( Bits - shiftBits ) ).isZero() == false;
+        }
+        overflowed( lost != 0, "FixedInt::operator<<=" );
+
+        LI_UNROLL
+        for( index = digitShift; index < DIGITS; index++ )
+        {
+            result[ index ] = digits[ index - digitShift ] << bitShift;
+            if( bitShift && index > digitShift )
+            {
+                result[ index ] |= digits[ index - digitShift - 1 ] >>
+                                   ( LI_Properties::digit::SIZE - bitShift );
+            }
+        }
+
+        copyDigits( result );
+        return *this;
+    }
+
+    constexpr FixedInt &operator>>=( unsigned int shiftBits )
+    {
+        unsigned int digitShift = shiftBits / LI_Properties::digit::SIZE;
+        unsigned int bitShift = shiftBits % LI_Properties::digit::SIZE;
+        LI_Properties::digit::type result[ DIGITS ] = {};
+        unsigned int index = 0;
+
+        LI_UNROLL
+        for( index = 0; index + digitShift < DIGITS; index++ )
+        {
+            result[ index ] = digits[ index + digitShift ] >> bitShift;
+            if( bitShift && index + digitShift + 1 < DIGITS )
+            {
+                result[ index ] |= digits[ index + digitShift + 1 ] <<
+                                   ( LI_Properties::digit::SIZE - bitShift );
+            }
+        }
+
+        copyDigits( result );
+        return *this;
+    }
+
+    // returns <0, 0 or >0 like spaceshipComp
+    constexpr int compare( const FixedInt &other ) const
+    {
+        unsigned int index = 0;
+
+        for( index = DIGITS; index > 0; index-- )
+        {
+            if( digits[ index - 1 ] != other.digits[ index - 1 ] )
+            {
+                return digits[ index - 1 ] < other.digits[ index - 1 ] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    friend constexpr FixedInt operator+( FixedInt one, const FixedInt &other )
+    {
+        return one += other;
+    }
+    friend constexpr FixedInt operator-( FixedInt one, const FixedInt &other )
+    {
+        return one -= other;
+    }
+    friend constexpr FixedInt operator*( FixedInt one, const FixedInt &other )
+    {
+        return one *= other;
+    }
+    friend constexpr FixedInt operator<<( FixedInt value, unsigned int shiftBits )
+    {
+        return value <<= shiftBits;
+    }
+    friend constexpr FixedInt operator>>( FixedInt value, unsigned int shiftBits )
+    {
+        return value >>= shiftBits;
+    }
+
+    friend constexpr bool operator==( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) == 0;
+    }
+    friend constexpr bool operator!=( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) != 0;
+    }
+    friend constexpr bool operator<( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) < 0;
+    }
+    friend constexpr bool operator<=( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) <= 0;
+    }
+    friend constexpr bool operator>( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) > 0;
+    }
+    friend constexpr bool operator>=( const FixedInt &one, const FixedInt &other )
+    {
+        return one.compare( other ) >= 0;
+    }
+
+private:
+    constexpr void copyDigits( const LI_Properties::digit::type *source )
+    {
+        unsigned int index = 0;
+
+        LI_UNROLL
+        for( index = 0; index < DIGITS; index++ )
+        {
+            digits[ index ] = source[ index ];
+        }
+    }
+};
+
+
+#endif // FIXED_INT_H
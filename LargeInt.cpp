@@ -1,1053 +1,5300 @@
 #include "LargeInt.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <memory> // std::unique_ptr
+#include <exception> // std::exception_ptr
+#include <cerrno>
+#include <cctype> // tolower
+
+// file descriptor output
+#if defined( _WIN32 )
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+
+// digits are stored as the binary format lays them out
+#if ( defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ) \
+    || defined( _WIN32 )
+#define LI_LITTLE_ENDIAN
+#endif
+
+// x86-64 carry instructions (adc/sbb intrinsics, mulx/adcx/adox)
+#if LI_DIGIT_BITS == 64 && defined( __x86_64__ ) && defined( __GNUC__ )
+#define LI_X86_64_KERNELS
+#include <x86intrin.h>
+#endif
+
+
+/////////////////////////////// memory management //////////////////////////////
+static void *defaultAllocate( size_t bytes )
+{
+    return ::operator new( bytes );
+}
 
-LargeInt::LargeInt( const LargeInt &source )
+static void defaultDeallocate( void *memory, size_t )
 {
-   initializeMemory();
-   resize( source.size );
-   copyArray( source.digits, digits, size );
-   sign = source.sign;
+    ::operator delete( memory );
 }
 
-LargeInt::LargeInt()
+static LargeIntAllocator currentAllocator = { defaultAllocate, defaultDeallocate };
+
+// set once the thread's arena is destroyed (LargeInts released afterwards,
+// e.g. statics, go straight to the allocator)
+static thread_local bool localArenaDestroyed = false;
+
+void setLargeIntAllocator( const LargeIntAllocator &allocator )
 {
-    initializeMemory();
-    sign = false;
+    currentAllocator = allocator;
 }
 
-void LargeInt::operator=( const LargeInt &source )
+const LargeIntAllocator &getLargeIntAllocator()
 {
-    // delete original memory
-    delete []digits;
+    return currentAllocator;
+}
 
-    initializeMemory();
-    resize( source.size );
-    copyArray( source.digits, digits, size );
-    sign = source.sign;
+LargeIntArena &LargeIntArena::local()
+{
+    static thread_local LargeIntArena arena;
+    return arena;
 }
 
-LargeInt::LargeInt( const int &source )
+LargeIntArena::LargeIntArena()
 {
-    initializeMemory();
-    // set to size 0 if value is 0
-    if( source == 0 )
-    {
-        resize( 0 );
-    }
-    else
+    unsigned int classInd;
+
+    chunkCount = 0;
+    currentChunk = 0;
+    scratchBytes = 0;
+    peakScratchBytes = 0;
+    pooledBytes = 0;
+    for( classInd = 0; classInd < LI_Properties::memory::POOL_CLASSES; classInd++ )
     {
-        // space for 1 digit
-        resize( 1 );
-        // set first element to absolute value of source
-        *digits = abs( source );
-        // set sign to 'source is negative'
-        sign = source < 0;
+        pooledCount[ classInd ] = 0;
     }
 }
 
-LargeInt::LargeInt( const LI_Properties::digit::type &source )
+LargeIntArena::~LargeIntArena()
 {
-    initializeMemory();
-    if( source == 0 )
+    currentChunk = 0;
+    scratchBytes = 0;
+    trim();
+    localArenaDestroyed = true;
+}
+
+void *LargeIntArena::allocateScratch( size_t bytes )
+{
+    void *memory;
+
+    // keep every allocation 16 byte aligned
+    bytes = ( bytes + 15 ) & ~(size_t)15;
+
+    // move past chunks without room (chunks after the current are empty)
+    while( currentChunk < chunkCount && 
+           chunks[ currentChunk ].capacity - chunks[ currentChunk ].used < bytes )
     {
-        resize( 0 );
+        currentChunk++;
     }
-    else
+
+    // no chunk fits: add one, at least double the last
+    if( currentChunk == chunkCount )
     {
-        // space for 1 digit
-        resize( 1 );
-        // set first element to source (unsigned)
-        *digits = source;
+        if( chunkCount == LI_Properties::memory::ARENA_MAX_CHUNKS )
+        {
+            throw std::overflow_error( "out of scratch chunks in "
+                                       "LargeIntArena::allocateScratch\n" );
+        }
+        chunks[ chunkCount ].capacity = max( bytes, LI_Properties::memory::ARENA_CHUNK_BYTES );
+        if( chunkCount > 0 )
+        {
+            chunks[ chunkCount ].capacity = max( chunks[ chunkCount ].capacity, 
+                                                 2 * chunks[ chunkCount - 1 ].capacity );
+        }
+        chunks[ chunkCount ].memory = (char *)currentAllocator.allocate( 
+                                                  chunks[ chunkCount ].capacity );
+        chunks[ chunkCount ].used = 0;
+        chunkCount++;
     }
+
+    memory = chunks[ currentChunk ].memory + chunks[ currentChunk ].used;
+    chunks[ currentChunk ].used += bytes;
+    scratchBytes += bytes;
+    peakScratchBytes = max( peakScratchBytes, scratchBytes );
+    return memory;
 }
 
-LargeInt::LargeInt( const std::string &numericString, unsigned int base )
+LargeIntArena::Mark LargeIntArena::mark() const
 {
-    std::string::const_iterator wkgChar;
-    bool hasSign;
-    initializeMemory();
-    *this = LargeInt( 0 );
+    Mark currentMark;
+    currentMark.chunk = currentChunk;
+    currentMark.used = currentChunk < chunkCount ? chunks[ currentChunk ].used : 0;
+    return currentMark;
+}
 
-    // empty string -> 0
-    if( numericString.size() == 0 )
+void LargeIntArena::release( const Mark &toMark )
+{
+    unsigned int chunkInd;
+
+    // empty every chunk after the mark's, then cut the mark's back
+    for( chunkInd = toMark.chunk + 1; chunkInd <= currentChunk && 
+                                      chunkInd < chunkCount; chunkInd++ )
     {
-        return;
+        scratchBytes -= chunks[ chunkInd ].used;
+        chunks[ chunkInd ].used = 0;
     }
+    if( toMark.chunk < chunkCount )
+    {
+        scratchBytes -= chunks[ toMark.chunk ].used - toMark.used;
+        chunks[ toMark.chunk ].used = toMark.used;
+    }
+    currentChunk = toMark.chunk;
+}
 
-    // set iterator
-    wkgChar = numericString.begin();
+LI_Properties::digit::type *LargeIntArena::allocateDigits( unsigned int &capacity )
+{
+    unsigned int sizeClass = 0;
 
-    // set sign if present
-    if( *wkgChar == '-' )
+    // round to the size class, taking a released array if one is kept
+    while( ( 1u << sizeClass ) < capacity )
     {
-        hasSign = true;
-        wkgChar++;
+        sizeClass++;
     }
-    else
+    if( sizeClass < LI_Properties::memory::POOL_CLASSES )
     {
-        hasSign = false;
+        capacity = 1u << sizeClass;
+        if( pooledCount[ sizeClass ] > 0 )
+        {
+            pooledCount[ sizeClass ]--;
+            pooledBytes -= (size_t)capacity * sizeof( LI_Properties::digit::type );
+            return pooled[ sizeClass ][ pooledCount[ sizeClass ] ];
+        }
     }
 
-    // iterate most significant->least
-    while( wkgChar != numericString.end() )
+    return (LI_Properties::digit::type *)currentAllocator.allocate( 
+               (size_t)capacity * sizeof( LI_Properties::digit::type ) );
+}
+
+void LargeIntArena::deallocateDigits( LI_Properties::digit::type *digits, 
+                                      unsigned int capacity )
+{
+    size_t bytes = (size_t)capacity * sizeof( LI_Properties::digit::type );
+    unsigned int sizeClass = 0;
+
+    while( ( 1u << sizeClass ) < capacity )
     {
-        *this = *this * base + LargeInt( charToInt( *wkgChar ) );
-        wkgChar++;
+        sizeClass++;
     }
 
-    sign = hasSign;
-}
+    // keep pool sized arrays while the class and the pool have room
+    if( sizeClass < LI_Properties::memory::POOL_CLASSES && 
+        capacity == 1u << sizeClass &&
+        pooledCount[ sizeClass ] < LI_Properties::memory::POOL_BLOCKS_PER_CLASS &&
+        pooledBytes + bytes <= LI_Properties::memory::POOL_MAX_BYTES )
+    {
+        pooled[ sizeClass ][ pooledCount[ sizeClass ] ] = digits;
+        pooledCount[ sizeClass ]++;
+        pooledBytes += bytes;
+        return;
+    }
 
-LargeInt::~LargeInt()
-{
-    delete []digits;
+    currentAllocator.deallocate( digits, bytes );
 }
 
-void LargeInt::initializeMemory( int initialMemory )
+LargeIntArena::Stats LargeIntArena::getStats() const
 {
-    capacity = initialMemory;
-    digits = new LI_Properties::digit::type[ capacity ];
+    Stats currentStats;
+    unsigned int index;
 
-    sign = 0; // default 0
-    size = 0;
+    currentStats.scratchBytes = scratchBytes;
+    currentStats.peakScratchBytes = peakScratchBytes;
+    currentStats.reservedScratchBytes = 0;
+    for( index = 0; index < chunkCount; index++ )
+    {
+        currentStats.reservedScratchBytes += chunks[ index ].capacity;
+    }
+    currentStats.pooledBytes = pooledBytes;
+    return currentStats;
 }
 
+void LargeIntArena::resetPeak()
+{
+    peakScratchBytes = scratchBytes;
+}
 
-void LargeInt::resize( unsigned int newSize )
+void LargeIntArena::trim()
 {
-    // error handle oversizing
-    if( newSize > 0xFFFFFF )
+    unsigned int classInd;
+
+    // empty chunks at the end (all of them when no scratch is in use)
+    while( chunkCount > 0 && 
+           ( chunkCount - 1 > currentChunk || scratchBytes == 0 ) )
     {
-        throw std::overflow_error( "attempted to resize to "
-                                    + std::to_string( (int)newSize )
-                                    + " in LargeInt::resize\n" );
+        chunkCount--;
+        currentAllocator.deallocate( chunks[ chunkCount ].memory, 
+                                     chunks[ chunkCount ].capacity );
     }
-    unsigned int index;
-
-    // check size is increasing
-    if( newSize > size )
+    if( chunkCount == 0 )
     {
-        // reallocate if necessary
-        reallocate( newSize );
+        currentChunk = 0;
+    }
 
-        // set all digits from previous size to new size to 0
-        for( index = size; index < newSize; index++ )
+    for( classInd = 0; classInd < LI_Properties::memory::POOL_CLASSES; classInd++ )
+    {
+        while( pooledCount[ classInd ] > 0 )
         {
-            digits[ index ] = 0;
+            pooledCount[ classInd ]--;
+            currentAllocator.deallocate( pooled[ classInd ][ pooledCount[ classInd ] ],
+                                         ( (size_t)1 << classInd ) * 
+                                         sizeof( LI_Properties::digit::type ) );
         }
     }
-
-    // update to newSize
-    size = newSize;
+    pooledBytes = 0;
 }
 
-void LargeInt::reallocate( unsigned int newCapacity )
+// keeps the (cold) heap path out of the inline digit paths that call it
+#if defined( __GNUC__ )
+#define LI_NOINLINE __attribute__(( noinline ))
+#define LI_INLINE inline __attribute__(( always_inline ))
+#else
+#define LI_NOINLINE
+#define LI_INLINE inline
+#endif
+
+// heap digit arrays for LargeInts, through the thread's pool
+LI_NOINLINE static LI_Properties::digit::type *allocateDigitArray( unsigned int &capacity )
 {
-    LI_Properties::digit::type *newDigits;
+    if( localArenaDestroyed )
+    {
+        return (LI_Properties::digit::type *)currentAllocator.allocate( 
+                   (size_t)capacity * sizeof( LI_Properties::digit::type ) );
+    }
+    return LargeIntArena::local().allocateDigits( capacity );
+}
 
-    // only process if newCapacity greater than oldCapacity
-    if( newCapacity > capacity )
+LI_NOINLINE static void freeDigitArray( LI_Properties::digit::type *digits, unsigned int capacity )
+{
+    if( digits == NULL )
     {
-        // set newCapacity to double if larger than newCapacity
-        newCapacity = max( newCapacity, capacity * 2 );
+        return;
+    }
+    if( localArenaDestroyed )
+    {
+        currentAllocator.deallocate( digits, 
+                                     (size_t)capacity * sizeof( LI_Properties::digit::type ) );
+        return;
+    }
+    LargeIntArena::local().deallocateDigits( digits, capacity );
+}
 
-        // generate new array with new capacity
-        newDigits = new LI_Properties::digit::type[ newCapacity ];
 
-        // copy original data to newdigits
-        copyArray( digits, newDigits, size );
+/////////////////////////////// task pool ///////////////////////////////////////
+/* LargeIntTaskPool
+worker threads with a task queue each: a thread takes its newest task first
+(the pieces of the product it is working on) and steals the oldest from other
+queues (the largest pieces); threads outside the pool share one extra queue
+*/
+class LargeIntTaskPool
+{
+public:
+    typedef std::function<void()> Task;
 
-        // delete original memory
-        delete []digits;
+    static LargeIntTaskPool &shared();
 
-        // copy new data into attributes
-        digits = newDigits;
-        capacity = newCapacity;
-        // (size is unchanged)
-    }
-}
+    ~LargeIntTaskPool();
 
+    // threads including the calling one (workers are restarted)
+    void resize( unsigned int threadCount );
+    unsigned int threadCount() const { return queueCount; }
 
-void LargeInt::removeLeadingZeros()
-{
-    int newSize = size;
-    // iterate to non-zero digit
-    while( newSize > 0 && digits[ newSize - 1 ] == 0 )
+    void submit( Task task );
+    // runs one queued task, false if every queue was empty
+    bool runQueued();
+
+private:
+    struct Queue
     {
-        newSize--;
-    }
-    resize( newSize );
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    // a queue per worker, the last for threads outside the pool (set before
+    // the workers start, so they never read it while it changes)
+    std::unique_ptr<Queue[]> queues;
+    unsigned int queueCount;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    std::atomic<unsigned int> queuedCount;
+    bool stopping;
+
+    LargeIntTaskPool();
+    void stop();
+    void work( unsigned int queueInd );
+    unsigned int localQueue() const;
+};
+
+// the calling thread's queue index, or -1 outside the pool
+static thread_local int poolQueueInd = -1;
+
+LargeIntTaskPool &LargeIntTaskPool::shared()
+{
+    static LargeIntTaskPool pool;
+    return pool;
 }
 
+LargeIntTaskPool::LargeIntTaskPool() : queues( new Queue[ 1 ] ), queueCount( 1 ), 
+                                       queuedCount( 0 ), stopping( false )
+{
+}
 
-/*
-Before Call:
- - 'low' and 'high' must have memory allocated correctly (including base constrcutor)
-After Call:
- - 'low' and 'high' are a shallow copy, therefore the destructor cannot be called
-    - set digits to NULL for both to prevent the destructor from erroring
-    - low and high must be treated as constant after this function is called
-       - before modifying anything, set digits to NULL for the corresponding LI
- - low begins at the start of this->digits, high begins at the splitInd of this->digits
-    - low ends at this->digits[ splitInd ] (exclusive)
-    - high ends at this->digits[ size ] (exclusive)
+LargeIntTaskPool::~LargeIntTaskPool()
+{
+    stop();
+}
 
-Requirements:
- - splitInd must be no greater than the size of this
-*/
-void LargeInt::shallowSplit( LargeInt &low, LargeInt &high, 
-                             unsigned int splitInd ) const
+void LargeIntTaskPool::stop()
 {
-    if( splitInd >= size )
+    unsigned int workerInd;
+
+    {
+        std::lock_guard<std::mutex> guard( sleepLock );
+        stopping = true;
+    }
+    wake.notify_all();
+    for( workerInd = 0; workerInd < workers.size(); workerInd++ )
     {
-        throw std::overflow_error( "splitInd is greater than the size\n" );
+        workers[ workerInd ].join();
     }
+    workers.clear();
+    stopping = false;
+}
 
-    // reset data of low/high
-    low = LargeInt();
-    high = LargeInt();
+void LargeIntTaskPool::resize( unsigned int threadCount )
+{
+    unsigned int workerInd;
 
-    // assign low to start of digits, high to digits + splitInd
-    low.digits = digits; // include start
-    high.digits = digits + splitInd; // include splitInd
+    stop();
 
-    // assign sizes and capacities (same size/capacity for both)
-    low.size = splitInd;
-    low.capacity = low.size;
-    high.size = size - low.size;
-    high.capacity = high.size;
+    queues.reset( new Queue[ threadCount ] );
+    queueCount = threadCount;
+    for( workerInd = 0; workerInd + 1 < threadCount; workerInd++ )
+    {
+        workers.push_back( std::thread( &LargeIntTaskPool::work, this, workerInd ) );
+    }
+}
 
-    // assign signs to same as parent
-    low.sign = sign;
-    high.sign = sign;
+unsigned int LargeIntTaskPool::localQueue() const
+{
+    return poolQueueInd < 0 ? queueCount - 1 : (unsigned int)poolQueueInd;
 }
 
-LargeInt::operator int() const
+void LargeIntTaskPool::submit( Task task )
 {
-    if( size == 0 )
+    Queue &queue = queues[ localQueue() ];
+
+    // (counted first, so the count never drops below the queued tasks)
+    queuedCount++;
     {
-        return 0;
+        std::lock_guard<std::mutex> guard( queue.lock );
+        queue.tasks.push_back( std::move( task ) );
     }
-    if( sign )
+
+    // (taking the lock orders the count before a sleeping worker's check)
     {
-        return -digits[ 0 ];
+        std::lock_guard<std::mutex> guard( sleepLock );
     }
-    return digits[ 0 ];
+    wake.notify_one();
 }
 
-
-
-
-//////////////////////////// LargeInt Display /////////////////////////////////
-std::string LargeInt::toBinary() const
+bool LargeIntTaskPool::runQueued()
 {
-    std::string outstr;
-    int index;
+    unsigned int queueCount = threadCount();
+    unsigned int ownInd = localQueue();
+    unsigned int offset, queueInd;
+    Task task;
 
-    if( size == 0 )
+    if( queuedCount == 0 )
     {
-        outstr = "0";
+        return false;
     }
-    else
+
+    // own queue newest first, then the others oldest first
+    for( offset = 0; offset < queueCount && !task; offset++ )
     {
-        if( sign )
+        queueInd = ( ownInd + offset ) % queueCount;
+        std::lock_guard<std::mutex> guard( queues[ queueInd ].lock );
+        if( queues[ queueInd ].tasks.empty() )
         {
-            outstr += "-";
+            continue;
         }
-
-        for( index = size - 1; index >= 0; index-- )
+        if( offset == 0 )
         {
-             outstr += toBinaryString( digits[ index ] );
+            task = std::move( queues[ queueInd ].tasks.back() );
+            queues[ queueInd ].tasks.pop_back();
         }
+        else
+        {
+            task = std::move( queues[ queueInd ].tasks.front() );
+            queues[ queueInd ].tasks.pop_front();
+        }
+    }
+    if( !task )
+    {
+        return false;
     }
 
-    return outstr;
+    queuedCount--;
+    task();
+    return true;
 }
 
+void LargeIntTaskPool::work( unsigned int queueInd )
+{
+    bool ranTasks = false;
+
+    poolQueueInd = (int)queueInd;
 
+    for( ;; )
+    {
+        if( runQueued() )
+        {
+            ranTasks = true;
+            continue;
+        }
 
+        // return the memory the tasks used before sleeping (workers live
+        // as long as the pool)
+        if( ranTasks )
+        {
+            LargeIntArena::local().trim();
+            ranTasks = false;
+        }
 
-//////////////////////////// operators ////////////////////////////////////////
-////////////// shifting ///////////////
-void LargeInt::digitShiftLesser( int shiftAmount )
+        std::unique_lock<std::mutex> sleeping( sleepLock );
+        wake.wait( sleeping, [this] { return stopping || queuedCount != 0; } );
+        if( stopping )
+        {
+            return;
+        }
+    }
+}
+
+/* LargeIntTaskGroup
+tasks run on the shared pool (or right away with a single thread); wait()
+runs queued tasks until all of the group's tasks are done, then rethrows the
+first exception one of them threw
+*/
+class LargeIntTaskGroup
 {
-    unsigned int newInd, oldInd;
+public:
+    LargeIntTaskGroup() : pool( LargeIntTaskPool::shared() ), pending( 0 ) {}
+    ~LargeIntTaskGroup() { finish(); }
 
-    // shift greater instead if shiftAmount is negative
-    if( shiftAmount < 0 )
+    void run( const LargeIntTaskPool::Task &task );
+    void wait();
+
+private:
+    LargeIntTaskPool &pool;
+    std::atomic<unsigned int> pending;
+    std::mutex errorLock;
+    std::exception_ptr error;
+
+    void finish();
+};
+
+void LargeIntTaskGroup::run( const LargeIntTaskPool::Task &task )
+{
+    if( pool.threadCount() == 1 )
     {
-        digitShiftGreater( -shiftAmount );
+        task();
         return;
     }
 
-    // initial: new = start, old = start + shiftAmount
-    // update: increment both
-    // terminate: old out of upper bound
-    for( newInd = 0, oldInd = shiftAmount; 
-             oldInd < size; 
-                 newInd++, oldInd++ )
+    pending++;
+    pool.submit( [this, task]
     {
-        // store old value into new position
-        digits[ newInd ] = digits[ oldInd ];
+        try
+        {
+            task();
+        }
+        catch( ... )
+        {
+            std::lock_guard<std::mutex> guard( errorLock );
+            if( !error )
+            {
+                error = std::current_exception();
+            }
+        }
+        pending--;
+    } );
+}
+
+void LargeIntTaskGroup::finish()
+{
+    while( pending != 0 )
+    {
+        if( !pool.runQueued() )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void LargeIntTaskGroup::wait()
+{
+    finish();
+    if( error )
+    {
+        std::rethrow_exception( error );
+    }
+}
+
+void setLargeIntThreadCount( unsigned int threadCount )
+{
+    if( threadCount == 0 )
+    {
+        threadCount = max( std::thread::hardware_concurrency(), 1u );
     }
+    LargeIntTaskPool::shared().resize( threadCount );
+}
 
-    // decrement size by shiftAmount
-    size -= shiftAmount;
+unsigned int getLargeIntThreadCount()
+{
+    return LargeIntTaskPool::shared().threadCount();
 }
 
+// true if multiplications and conversions may use the pool
+static bool runsInParallel()
+{
+    return LargeIntTaskPool::shared().threadCount() > 1;
+}
 
-void LargeInt::digitShiftGreater( int shiftAmount )
+// calls body( first, last ) over ranges covering [ 0, count ), in parallel
+// ranges of at least grain items when running in parallel
+template <class Body>
+static void parallelRanges( unsigned int count, unsigned int grain, const Body &body )
 {
-    int oldInd, oldSize;
+    LargeIntTaskGroup group;
+    unsigned int rangeSize, first;
 
-    // shift lesser instead if shiftAmount is negative
-    if( shiftAmount < 0 )
+    if( count <= grain || !runsInParallel() )
     {
-        digitShiftLesser( -shiftAmount );
+        body( 0u, count );
         return;
     }
 
-    // do nothing if value is 0 (keep size consistent)
-    if( size == 0 )
+    // a few ranges per thread, so stolen ranges even out
+    rangeSize = max( grain, count / ( 4 * getLargeIntThreadCount() ) );
+    for( first = rangeSize; first < count; first += rangeSize )
     {
-        return;
+        group.run( [&body, first, rangeSize, count] 
+                   { body( first, min( first + rangeSize, count ) ); } );
     }
+    body( 0u, rangeSize );
+    group.wait();
+}
 
-    // add shiftAmount to size
-    oldSize = size;
-    resize( oldSize + shiftAmount );
 
-    // initial: old = size - 1
-    // update: old -= 1
-    // terminate: oldInd out of lower bound
-    for( oldInd = oldSize - 1; oldInd >= 0; oldInd-- )
+
+
+LargeInt::LargeInt( const LargeInt &source )
+{
+   initializeMemory( source.size );
+   size = source.size;
+   copyArray( source.digits, digits, size );
+   sign = source.sign;
+}
+
+LargeInt::LargeInt( LargeInt &&source ) noexcept
+{
+    size = source.size;
+    capacity = source.capacity;
+    sign = source.sign;
+
+    if( source.hasInlineDigits() )
     {
-        // store old value into new space (new = old + shiftAmount)
-        digits[ oldInd + shiftAmount ] = digits[ oldInd ];
+        // inline digits cannot be taken, copy them
+        digits = inlineDigits;
+        copyArray( source.inlineDigits, inlineDigits, size );
+    }
+    else
+    {
+        // take the source's memory
+        digits = source.digits;
     }
 
-    // store 0 in remaining spaces
-    for( oldInd = oldInd + shiftAmount; oldInd >= 0; oldInd-- )
+    // leave the source as 0 in its inline digits
+    source.digits = source.inlineDigits;
+    source.size = 0;
+    source.capacity = LI_Properties::INLINE_CAPACITY;
+    source.sign = false;
+}
+
+LargeInt::LargeInt()
+{
+    initializeMemory();
+    sign = false;
+}
+
+LargeInt &LargeInt::operator=( const LargeInt &source )
+{
+    if( this == &source )
     {
-        digits[ oldInd ] = 0;
+        return *this;
+    }
+
+    // reuse current memory if it is large enough
+    if( capacity < source.size )
+    {
+        // delete original memory
+        if( !hasInlineDigits() )
+        {
+            freeDigitArray( digits, capacity );
+        }
+
+        initializeMemory( source.size );
     }
+    size = source.size;
+    copyArray( source.digits, digits, size );
+    sign = source.sign;
+
+    return *this;
 }
 
-void operator <<= ( LargeInt &toShift, int shiftAmount )
+LargeInt &LargeInt::operator=( LargeInt &&source ) noexcept
 {
-    unsigned int shiftDigits, shiftBits;
-    unsigned int currentRemainder, nextRemainder;
-    unsigned int digitInd;
+    if( this == &source )
+    {
+        return *this;
+    }
 
-    // calculate digits to shift and bits to shift
-    shiftDigits = shiftAmount / LI_Properties::digit::SIZE;
-    shiftBits = shiftAmount % LI_Properties::digit::SIZE;
+    if( source.hasInlineDigits() )
+    {
+        // inline digits cannot be taken, copy them (always fits)
+        copyArray( source.inlineDigits, digits, source.size );
+    }
+    else
+    {
+        // take the source's memory, freeing the original
+        if( !hasInlineDigits() )
+        {
+            freeDigitArray( digits, capacity );
+        }
+        digits = source.digits;
+        capacity = source.capacity;
+        source.digits = source.inlineDigits;
+        source.capacity = LI_Properties::INLINE_CAPACITY;
+    }
+    size = source.size;
+    sign = source.sign;
 
-    // shift by digits
-    toShift.digitShiftGreater( shiftDigits );
+    // leave the source as 0
+    source.size = 0;
+    source.sign = false;
 
-    if( shiftBits != 0 )
+    return *this;
+}
+
+LargeInt::LargeInt( const int &source )
+{
+    initializeMemory();
+    // set to size 0 if value is 0
+    if( source == 0 )
     {
-        // add an extra digit to the end (may be removed later if unneeded)
-        toShift.resize( toShift.size + 1 );
+        resize( 0 );
+    }
+    else
+    {
+        // space for 1 digit
+        resize( 1 );
+        // set first element to absolute value of source
+        *digits = abs( source );
+        // set sign to 'source is negative'
+        sign = source < 0;
+    }
+}
 
-        // first digit has remainder 0
-        currentRemainder = 0;
+LargeInt::LargeInt( const LI_Properties::digit::type &source )
+{
+    initializeMemory();
+    if( source == 0 )
+    {
+        resize( 0 );
+    }
+    else
+    {
+        // space for 1 digit
+        resize( 1 );
+        // set first element to source (unsigned)
+        *digits = source;
+    }
+}
 
-        // shift bits in each digit by bits to shift (skip last)
-        for( digitInd = 0; digitInd < toShift.size; digitInd++ )
+void LargeInt::setInteger( unsigned long long magnitude, bool negative )
+{
+    unsigned int index = 0;
+
+    // one digit at a time (two for 32 bit digits)
+    resize( 0 );
+    while( magnitude != 0 )
+    {
+        resize( index + 1 );
+        digits[ index ] = (LI_Properties::digit::type)magnitude;
+        magnitude = (unsigned long long)( (LI_Properties::digit::doubleSize::type)magnitude 
+                                          >> LI_Properties::digit::SIZE );
+        index++;
+    }
+    sign = negative && size != 0;
+}
+
+/* combineChunks
+returns sum of chunks[ index ] * chunkBase^index, for chunks least
+significant first, with chunkBase^(2^level) from the power cache
+
+the top chunks are combined recursively and multiplied past the bottom
+2^level chunks (the largest power of two below count), so every
+multiplication is roughly balanced
+*/
+static LargeInt combineChunks( const LI_Properties::digit::type *chunks, 
+                               unsigned int count, 
+                               LargeIntPowerCache &powerCache )
+{
+    unsigned int level = 0;
+    unsigned int index;
+    LargeInt result;
+
+    // small counts: multiply in one chunk at a time
+    if( count <= LI_Properties::conversion::PARSE_CHUNK_THRESHOLD )
+    {
+        for( index = count; index > 0; index-- )
         {
-            nextRemainder = toShift.digits[ digitInd ] >> 
-                            ( LI_Properties::digit::SIZE - shiftBits );
-            toShift.digits[ digitInd ] = currentRemainder + 
-                                         ( toShift.digits[ digitInd ] << shiftBits );
-            currentRemainder = nextRemainder;
+            result *= powerCache.getChunkBase();
+            result.addDigitAtIndex( chunks[ index - 1 ], 0 );
         }
+        return result;
+    }
 
-        toShift.removeLeadingZeros();
+    // largest power of two below count
+    while( ( 2u << level ) < count )
+    {
+        level++;
+    }
+
+    // the halves are independent: the lower one runs as a task when large
+    if( count >= LI_Properties::conversion::PARALLEL_THRESHOLD && runsInParallel() )
+    {
+        LargeIntTaskGroup group;
+        LargeInt lower;
+
+        group.run( [&lower, chunks, level, &powerCache]
+                   { lower = combineChunks( chunks, 1u << level, powerCache ); } );
+        result = combineChunks( chunks + ( 1u << level ), count - ( 1u << level ), 
+                                powerCache ) * powerCache.power( level );
+        group.wait();
+        return result + lower;
     }
+
+    result = combineChunks( chunks + ( 1u << level ), count - ( 1u << level ), 
+                            powerCache ) * powerCache.power( level );
+    return result + combineChunks( chunks, 1u << level, powerCache );
 }
 
-void operator >>= ( LargeInt &toShift, int shiftAmount )
+// combineChunks over every chunk, with the powers computed up front
+// (parallel halves only read the cache)
+static LargeInt combineChunkArray( const LI_Properties::digit::type *chunks, 
+                                   unsigned int count, 
+                                   LargeIntPowerCache &powerCache )
 {
-    unsigned int shiftDigits, shiftBits;
-    unsigned int currentRemainder, nextRemainder;
-    int digitInd;
+    if( count > LI_Properties::conversion::PARSE_CHUNK_THRESHOLD )
+    {
+        powerCache.precompute( count );
+    }
+    return combineChunks( chunks, count, powerCache );
+}
 
-    // calculate digits to shift and bits to shift
-    shiftDigits = shiftAmount / LI_Properties::digit::SIZE;
-    shiftBits = shiftAmount % LI_Properties::digit::SIZE;
+LargeInt::LargeInt( const std::string &numericString, unsigned int base )
+{
+    std::string::const_iterator wkgChar, chunkStart, chunkEnd;
+    LI_Properties::digit::type *chunks;
+    LargeIntScratchScope scratch;
+    unsigned int chunkDigits, chunkCount, chunkInd, bitsPerChar;
+    bool hasSign;
+    initializeMemory();
+    *this = LargeInt( 0 );
 
-    // shift by digits
-    toShift.digitShiftLesser( shiftDigits );
+    // empty string -> 0
+    if( numericString.size() == 0 )
+    {
+        return;
+    }
 
-    if( shiftBits != 0 )
+    // set iterator
+    wkgChar = numericString.begin();
+
+    // set sign if present
+    if( *wkgChar == '-' )
     {
-        // last digit has remainder 0
-        currentRemainder = 0;
+        hasSign = true;
+        wkgChar++;
+    }
+    else
+    {
+        hasSign = false;
+    }
 
-        // shift bits in each digit by bits to shift (skip last)
-        for( digitInd = toShift.size - 1; digitInd >= 0; digitInd-- )
+    // power of two bases: pack the bits of each character directly
+    if( ( base & ( base - 1 ) ) == 0 )
+    {
+        for( bitsPerChar = 0; ( 1u << bitsPerChar ) < base; bitsPerChar++ );
+        parsePowerOfTwoBase( wkgChar, numericString.end(), bitsPerChar );
+        sign = hasSign && size != 0;
+        return;
+    }
+
+    LargeIntPowerCache &powerCache = sharedPowerCache( base );
+    chunkDigits = powerCache.getChunkDigits();
+
+    // read chunks least significant first (the most significant is partial)
+    chunkCount = ( numericString.end() - wkgChar + chunkDigits - 1 ) / chunkDigits;
+    if( chunkCount == 0 )
+    {
+        return;
+    }
+    chunks = scratch.allocate<LI_Properties::digit::type>( chunkCount );
+    chunkEnd = numericString.end();
+    for( chunkInd = 0; chunkInd < chunkCount; chunkInd++ )
+    {
+        chunkStart = chunkEnd - min( chunkDigits, (unsigned int)( chunkEnd - wkgChar ) );
+        chunks[ chunkInd ] = 0;
+        while( chunkStart != chunkEnd )
         {
-            nextRemainder = toShift.digits[ digitInd ] << 
-                                 ( LI_Properties::digit::SIZE - shiftBits );
-            toShift.digits[ digitInd ] = ( toShift.digits[ digitInd ] >> shiftBits )
-                                          + currentRemainder;
-            currentRemainder = nextRemainder;
+            chunks[ chunkInd ] = chunks[ chunkInd ] * base + charToInt( *chunkStart );
+            chunkStart++;
         }
-
-        // remove leading zeros
-        toShift.removeLeadingZeros();
+        chunkEnd -= min( chunkDigits, (unsigned int)( chunkEnd - wkgChar ) );
     }
-}
 
+    *this = combineChunkArray( chunks, chunkCount, powerCache );
+    sign = hasSign && size != 0;
+}
 
-LargeInt operator<<( LargeInt &toShift, int shiftVal )
+void LargeInt::parsePowerOfTwoBase( std::string::const_iterator first, 
+                                    std::string::const_iterator last, 
+                                    unsigned int bitsPerChar )
 {
-    LargeInt result = toShift;
-    result <<= shiftVal;
-    return result;
+    LI_Properties::digit::doubleSize::type accumulator = 0;
+    unsigned int accumulatedBits = 0;
+    unsigned int digitInd = 0;
+
+    resize( ( ( last - first ) * bitsPerChar + LI_Properties::digit::SIZE - 1 ) /
+            LI_Properties::digit::SIZE );
+
+    // least significant character first, emptying whole digits as they fill
+    while( last != first )
+    {
+        last--;
+        accumulator |= (LI_Properties::digit::doubleSize::type)charToInt( *last ) << 
+                       accumulatedBits;
+        accumulatedBits += bitsPerChar;
+        if( accumulatedBits >= (unsigned int)LI_Properties::digit::SIZE )
+        {
+            digits[ digitInd ] = (LI_Properties::digit::type)accumulator;
+            digitInd++;
+            accumulator >>= LI_Properties::digit::SIZE;
+            accumulatedBits -= LI_Properties::digit::SIZE;
+        }
+    }
+    if( accumulatedBits > 0 )
+    {
+        digits[ digitInd ] = (LI_Properties::digit::type)accumulator;
+    }
+
+    removeLeadingZeros();
 }
 
-LargeInt operator>>( LargeInt &toShift, int shiftVal )
+LargeInt::~LargeInt()
 {
-    LargeInt result = toShift;
-    result >>= shiftVal;
-    return result;
+    if( !hasInlineDigits() )
+    {
+        freeDigitArray( digits, capacity );
+    }
 }
 
+void LargeInt::initializeMemory( int initialMemory )
+{
+    // small values live in the inline digits, without allocating
+    if( initialMemory <= (int)LI_Properties::INLINE_CAPACITY )
+    {
+        capacity = LI_Properties::INLINE_CAPACITY;
+        digits = inlineDigits;
+    }
+    else
+    {
+        capacity = initialMemory;
+        digits = allocateDigitArray( capacity );
+    }
+
+    sign = 0; // default 0
+    size = 0;
+}
 
 
-////////////// adding ///////////////
-LargeInt operator+( const LargeInt &one, const LargeInt &other )
+void LargeInt::resize( unsigned int newSize )
 {
-    LargeInt result;
-    const LargeInt *greater, *smaller;
+    // error handle oversizing
+    if( newSize > 0xFFFFFFF )
+    {
+        throw std::overflow_error( "attempted to resize to "
+                                    + std::to_string( (int)newSize )
+                                    + " in LargeInt::resize\n" );
+    }
+    unsigned int index;
 
-    // signs are the same: direct magnitude addition
-    if( one.sign == other.sign )
+    // check size is increasing
+    if( newSize > size )
     {
-        result = addMagnitude( one, other );
-        result.sign = one.sign;
-        return result;
+        // reallocate if necessary
+        reallocate( newSize );
+
+        // set all digits from previous size to new size to 0
+        for( index = size; index < newSize; index++ )
+        {
+            digits[ index ] = 0;
+        }
     }
-    // different signs
 
-    // identify greater/smaller LIs
-    if( one < other )
+    // update to newSize
+    size = newSize;
+}
+
+void LargeInt::reallocate( unsigned int newCapacity )
+{
+    LI_Properties::digit::type *newDigits;
+
+    // only process if newCapacity greater than oldCapacity
+    if( newCapacity > capacity )
+    {
+        // set newCapacity to double if larger than newCapacity
+        newCapacity = max( newCapacity, capacity * 2 );
+
+        // generate new array with new capacity (rounded up by the pool)
+        newDigits = allocateDigitArray( newCapacity );
+
+        // copy original data to newdigits
+        copyArray( digits, newDigits, size );
+
+        // delete original memory
+        if( !hasInlineDigits() )
+        {
+            freeDigitArray( digits, capacity );
+        }
+
+        // copy new data into attributes
+        digits = newDigits;
+        capacity = newCapacity;
+        // (size is unchanged)
+    }
+}
+
+
+void LargeInt::removeLeadingZeros()
+{
+    int newSize = size;
+    // iterate to non-zero digit
+    while( newSize > 0 && digits[ newSize - 1 ] == 0 )
+    {
+        newSize--;
+    }
+    resize( newSize );
+}
+
+
+/////////////////////////////// views ///////////////////////////////////////
+LargeInt::LargeInt( const LargeIntView &source )
+{
+    initializeMemory( source.size );
+    resize( source.size );
+    copyArray( source.digits, digits, source.size );
+    sign = source.sign;
+}
+
+LargeIntView::LargeIntView( const LI_Limbs::limb *limbs, size_t count, 
+                            bool negative )
+{
+    // ignore leading zeros (zero is never negative)
+    while( count > 0 && limbs[ count - 1 ] == 0 )
+    {
+        count--;
+    }
+    digits = limbs;
+    size = (unsigned int)count;
+    sign = negative && count != 0;
+}
+
+LargeIntView LargeIntView::slice( unsigned int start, unsigned int count ) const
+{
+    // empty if start is past the end
+    if( start >= size )
+    {
+        return LargeIntView();
+    }
+    return LargeIntView( digits + start, min( count, size - start ) );
+}
+
+LargeInt LargeInt::digitSlice( unsigned int start, unsigned int count ) const
+{
+    LargeInt result;
+
+    // empty if start is past the end
+    if( start < size )
+    {
+        // clamp count to the end of digits
+        count = min( count, size - start );
+        result.resize( count );
+        copyArray( digits + start, result.digits, count );
+        result.removeLeadingZeros();
+    }
+
+    return result;
+}
+
+LargeInt::operator int() const
+{
+    if( size == 0 )
+    {
+        return 0;
+    }
+    if( sign )
+    {
+        return -digits[ 0 ];
+    }
+    return digits[ 0 ];
+}
+
+
+
+
+//////////////////////////// LargeInt Display /////////////////////////////////
+std::string LargeInt::toBinary() const
+{
+    unsigned int index, bitInd, charInd;
+
+    if( size == 0 )
+    {
+        return (std::string)"0";
+    }
+
+    // every digit written in full, most significant first
+    std::string outstr( sign + size * LI_Properties::digit::SIZE, '0' );
+    charInd = outstr.size();
+    if( sign )
+    {
+        outstr[ 0 ] = '-';
+    }
+    for( index = 0; index < size; index++ )
+    {
+        for( bitInd = 0; bitInd < (unsigned int)LI_Properties::digit::SIZE; bitInd++ )
+        {
+            charInd--;
+            outstr[ charInd ] = (char)( '0' + ( ( digits[ index ] >> bitInd ) & 1 ) );
+        }
+    }
+
+    return outstr;
+}
+
+
+
+
+//////////////////////////// carry kernels ////////////////////////////////////
+/* the innermost digit loops, with no branch or comparison per digit to find
+the carry:
+ - x86-64 (64 bit digits): add and subtract chain the carry flag through
+   _addcarry_u64/_subborrow_u64 (adc/sbb); adding a multiple uses mulx with
+   two independent carry chains (adcx for the product's high halves, adox
+   for the digits added to), when cpuid reports ADX and BMI2
+ - otherwise: double size arithmetic, the carry is the upper half
+*/
+#if defined( LI_X86_64_KERNELS )
+static bool cpuHasMultiplyCarryExtensions()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports( "adx" ) && __builtin_cpu_supports( "bmi2" );
+}
+
+// checked once at startup (before then the portable path is used)
+static const bool hasMultiplyCarryExtensions = cpuHasMultiplyCarryExtensions();
+
+// result += value * multiplier over size (at least 1) digits, returning
+// the carry digit; the loop counter is stepped with lea and tested with
+// jrcxz, which leave both carry chains (CF and OF) untouched
+static LI_Properties::digit::type addMultipleMulx( LI_Properties::digit::type *result,
+                                                   const LI_Properties::digit::type *value,
+                                                   unsigned int size,
+                                                   LI_Properties::digit::type multiplier )
+{
+    unsigned long long carry = 0, low, high, count = size;
+
+    __asm__(
+        "xor %%eax, %%eax\n\t"          // clear CF and OF
+        "1:\n\t"
+        "mulx (%[value]), %[low], %[high]\n\t"
+        "adcx %[carry], %[low]\n\t"     // + previous high half
+        "adox (%[result]), %[low]\n\t"  // + digit added to
+        "mov %[low], (%[result])\n\t"
+        "mov %[high], %[carry]\n\t"
+        "lea 8(%[value]), %[value]\n\t"
+        "lea 8(%[result]), %[result]\n\t"
+        "lea -1(%[count]), %[count]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %%eax\n\t"              // (mov keeps the flags)
+        "adcx %%rax, %[carry]\n\t"
+        "adox %%rax, %[carry]\n\t"
+        : [value] "+r" ( value ), [result] "+r" ( result ), [count] "+c" ( count ),
+          [carry] "+r" ( carry ), [low] "=&r" ( low ), [high] "=&r" ( high )
+        : "d" ( multiplier )
+        : "rax", "cc", "memory" );
+
+    return carry;
+}
+#endif
+
+// result = one + other over count digits, returning the carry (0 or 1)
+// (result may be one or other)
+static LI_Properties::digit::type addDigitsWithCarry( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *one, 
+                                    const LI_Properties::digit::type *other, 
+                                    unsigned int count )
+{
+    unsigned int index = 0;
+#if defined( LI_X86_64_KERNELS )
+    unsigned char carry = 0;
+    unsigned long long sum;
+
+    // (unrolled so the carry flag stays live across digits)
+    for( ; index + 4 <= count; index += 4 )
+    {
+        carry = _addcarry_u64( carry, one[ index ], other[ index ], &sum );
+        result[ index ] = sum;
+        carry = _addcarry_u64( carry, one[ index + 1 ], other[ index + 1 ], &sum );
+        result[ index + 1 ] = sum;
+        carry = _addcarry_u64( carry, one[ index + 2 ], other[ index + 2 ], &sum );
+        result[ index + 2 ] = sum;
+        carry = _addcarry_u64( carry, one[ index + 3 ], other[ index + 3 ], &sum );
+        result[ index + 3 ] = sum;
+    }
+    for( ; index < count; index++ )
+    {
+        carry = _addcarry_u64( carry, one[ index ], other[ index ], &sum );
+        result[ index ] = sum;
+    }
+    return carry;
+#else
+    LI_Properties::digit::doubleSize::type sum = 0;
+
+    for( ; index < count; index++ )
+    {
+        sum += (LI_Properties::digit::doubleSize::type)one[ index ] + 
+               other[ index ];
+        result[ index ] = (LI_Properties::digit::type)sum;
+        sum >>= LI_Properties::digit::SIZE;
+    }
+    return (LI_Properties::digit::type)sum;
+#endif
+}
+
+// result = one - other over count digits, returning the borrow (0 or 1)
+// (result may be one or other)
+static LI_Properties::digit::type subtractDigitsWithBorrow( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *one, 
+                                    const LI_Properties::digit::type *other, 
+                                    unsigned int count )
+{
+    unsigned int index = 0;
+#if defined( LI_X86_64_KERNELS )
+    unsigned char owe = 0;
+    unsigned long long difference;
+
+    for( ; index + 4 <= count; index += 4 )
+    {
+        owe = _subborrow_u64( owe, one[ index ], other[ index ], &difference );
+        result[ index ] = difference;
+        owe = _subborrow_u64( owe, one[ index + 1 ], other[ index + 1 ], &difference );
+        result[ index + 1 ] = difference;
+        owe = _subborrow_u64( owe, one[ index + 2 ], other[ index + 2 ], &difference );
+        result[ index + 2 ] = difference;
+        owe = _subborrow_u64( owe, one[ index + 3 ], other[ index + 3 ], &difference );
+        result[ index + 3 ] = difference;
+    }
+    for( ; index < count; index++ )
+    {
+        owe = _subborrow_u64( owe, one[ index ], other[ index ], &difference );
+        result[ index ] = difference;
+    }
+    return owe;
+#else
+    LI_Properties::digit::doubleSize::type difference;
+    LI_Properties::digit::type owe = 0;
+
+    // owe is set if the difference wrapped
+    for( ; index < count; index++ )
+    {
+        difference = (LI_Properties::digit::doubleSize::type)one[ index ] - 
+                     other[ index ] - owe;
+        result[ index ] = (LI_Properties::digit::type)difference;
+        owe = ( difference >> LI_Properties::digit::SIZE ) != 0;
+    }
+    return owe;
+#endif
+}
+
+
+
+//////////////////////////// digit array helpers //////////////////////////////
+// these operate directly on digit arrays (lower is less significant), without
+// constructing LargeInts, so the recursive algorithms can work in scratch memory
+
+// stores one + other into result, returning the carry out of the last digit
+// (inlined: for the one or two digit values most additions see, a call costs
+// more than the addition)
+// requirements:
+//  - oneSize must be at least otherSize
+//  - result must have space for oneSize digits (result may be one)
+LI_INLINE static LI_Properties::digit::type addDigitArrays( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *one, 
+                                    unsigned int oneSize,
+                                    const LI_Properties::digit::type *other, 
+                                    unsigned int otherSize )
+{
+    LI_Properties::digit::type carry;
+    unsigned int index;
+
+    // add overlapping digits
+    carry = addDigitsWithCarry( result, one, other, otherSize );
+
+    // propagate the carry through the rest of one
+    for( index = otherSize; index < oneSize && carry; index++ )
+    {
+        result[ index ] = one[ index ] + 1;
+        carry = result[ index ] == 0;
+    }
+
+    // copy remaining digits (unnecessary when adding in place)
+    if( result != one )
+    {
+        copyArray( one + index, result + index, oneSize - index );
+    }
+
+    return carry;
+}
+
+// stores one - other into result, returning the borrow out of the last digit
+// requirements:
+//  - oneSize must be at least otherSize
+//  - result must have space for oneSize digits (result may be one)
+LI_INLINE static LI_Properties::digit::type subtractDigitArrays( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *one, 
+                                    unsigned int oneSize,
+                                    const LI_Properties::digit::type *other, 
+                                    unsigned int otherSize )
+{
+    LI_Properties::digit::type owe;
+    unsigned int index;
+
+    // subtract overlapping digits
+    owe = subtractDigitsWithBorrow( result, one, other, otherSize );
+
+    // propagate the borrow through the rest of one
+    for( index = otherSize; index < oneSize && owe; index++ )
+    {
+        result[ index ] = one[ index ] - 1;
+        owe = result[ index ] == LI_Properties::digit::MAX;
+    }
+
+    // copy remaining digits (unnecessary when subtracting in place)
+    if( result != one )
+    {
+        copyArray( one + index, result + index, oneSize - index );
+    }
+
+    return owe;
+}
+
+// stores value * multiplier into result, returning the carry digit
+// (result may be value)
+static LI_Properties::digit::type multiplyDigitArray( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size,
+                                    LI_Properties::digit::type multiplier )
+{
+    LI_Properties::digit::doubleSize::type wkgProduct = 0;
+    unsigned int index;
+
+    for( index = 0; index < size; index++ )
+    {
+        // (max product + max digit still fits in double size)
+        wkgProduct += (LI_Properties::digit::doubleSize::type)value[ index ] * 
+                      multiplier;
+        result[ index ] = (LI_Properties::digit::type)wkgProduct;
+        wkgProduct >>= LI_Properties::digit::SIZE;
+    }
+
+    return (LI_Properties::digit::type)wkgProduct;
+}
+
+// stores digits / divisor into quotient, returning the remainder
+// (quotient may be digits)
+static LI_Properties::digit::type divideDigitArray( 
+                                    LI_Properties::digit::type *quotient,
+                                    const LI_Properties::digit::type *digits,
+                                    unsigned int size,
+                                    LI_Properties::digit::type divisor )
+{
+    LI_Properties::digit::doubleSize::type wkgValue = 0;
+    unsigned int index;
+
+    // iterate most significant->least, carrying the remainder down
+    for( index = size; index > 0; index-- )
+    {
+        wkgValue = ( wkgValue << LI_Properties::digit::SIZE ) | 
+                   digits[ index - 1 ];
+        quotient[ index - 1 ] = (LI_Properties::digit::type)( wkgValue / divisor );
+        wkgValue %= divisor;
+    }
+
+    return (LI_Properties::digit::type)wkgValue;
+}
+
+// subtracts value * multiplier from result[ 0 ] to result[ size ] (exclusive),
+// returning the digit borrowed past the last position
+static LI_Properties::digit::type subtractMultipleOfDigitArray( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size,
+                                    LI_Properties::digit::type multiplier )
+{
+    LI_Properties::digit::doubleSize::type wkgProduct;
+    LI_Properties::digit::type owe = 0;
+    LI_Properties::digit::type lowProduct;
+    unsigned int index;
+
+    for( index = 0; index < size; index++ )
+    {
+        // owe is the high half of the previous product, plus its borrow
+        wkgProduct = (LI_Properties::digit::doubleSize::type)value[ index ] * 
+                     multiplier + owe;
+        lowProduct = (LI_Properties::digit::type)wkgProduct;
+        owe = (LI_Properties::digit::type)( wkgProduct >> LI_Properties::digit::SIZE );
+
+        owe += result[ index ] < lowProduct;
+        result[ index ] -= lowProduct;
+    }
+
+    return owe;
+}
+
+// stores value << shiftBits into result, returning the bits shifted out
+// (shiftBits must be less than the digit size, result may be value)
+static LI_Properties::digit::type shiftLeftDigitArray( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size,
+                                    unsigned int shiftBits )
+{
+    LI_Properties::digit::type currentRemainder = 0;
+    LI_Properties::digit::type nextRemainder;
+    unsigned int index;
+
+    if( shiftBits == 0 )
+    {
+        copyArray( value, result, size );
+        return 0;
+    }
+
+    // least significant->most, carrying the top bits up
+    for( index = 0; index < size; index++ )
+    {
+        nextRemainder = value[ index ] >> ( LI_Properties::digit::SIZE - shiftBits );
+        result[ index ] = ( value[ index ] << shiftBits ) | currentRemainder;
+        currentRemainder = nextRemainder;
+    }
+
+    return currentRemainder;
+}
+
+// stores value >> shiftBits into result, returning the bits shifted out
+// (in the top of the returned digit)
+// (shiftBits must be less than the digit size, result may be value)
+static LI_Properties::digit::type shiftRightDigitArray( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size,
+                                    unsigned int shiftBits )
+{
+    LI_Properties::digit::type currentRemainder = 0;
+    LI_Properties::digit::type nextRemainder;
+    unsigned int index;
+
+    if( shiftBits == 0 )
+    {
+        copyArray( value, result, size );
+        return 0;
+    }
+
+    // most significant->least, carrying the low bits down
+    for( index = size; index > 0; index-- )
+    {
+        nextRemainder = value[ index - 1 ] << ( LI_Properties::digit::SIZE - shiftBits );
+        result[ index - 1 ] = ( value[ index - 1 ] >> shiftBits ) | currentRemainder;
+        currentRemainder = nextRemainder;
+    }
+
+    return currentRemainder;
+}
+
+// number of zero bits above the most significant set bit
+static unsigned int leadingZeroBits( LI_Properties::digit::type digit )
+{
+    unsigned int count = 0;
+
+    if( digit == 0 )
+    {
+        return LI_Properties::digit::SIZE;
+    }
+    while( !( digit >> ( LI_Properties::digit::SIZE - 1 ) ) )
+    {
+        digit <<= 1;
+        count++;
+    }
+    return count;
+}
+
+// number of digits once leading zeros are ignored
+static unsigned int significantSize( const LI_Properties::digit::type *digits,
+                                     unsigned int size )
+{
+    while( size > 0 && digits[ size - 1 ] == 0 )
+    {
+        size--;
+    }
+    return size;
+}
+
+// significant bits of digits[ 0 ] to digits[ size ] (exclusive)
+static unsigned int significantBits( const LI_Properties::digit::type *digits,
+                                     unsigned int size )
+{
+    return size == 0 ? 0 : 
+           size * LI_Properties::digit::SIZE - leadingZeroBits( digits[ size - 1 ] );
+}
+
+// compares magnitudes of two digit arrays (leading zeros are allowed),
+// returning <0, 0 or >0 like spaceshipMagComp
+static int compareDigitArrays( const LI_Properties::digit::type *one, 
+                               unsigned int oneSize,
+                               const LI_Properties::digit::type *other, 
+                               unsigned int otherSize )
+{
+    unsigned int index;
+
+    oneSize = significantSize( one, oneSize );
+    otherSize = significantSize( other, otherSize );
+    if( oneSize != otherSize )
+    {
+        return oneSize < otherSize ? -1 : 1;
+    }
+
+    // compare from the most significant digit down
+    for( index = oneSize; index > 0; index-- )
+    {
+        if( one[ index - 1 ] != other[ index - 1 ] )
+        {
+            return one[ index - 1 ] < other[ index - 1 ] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+
+
+
+//////////////////////////// operators ////////////////////////////////////////
+////////////// shifting ///////////////
+void LargeInt::digitShiftLesser( int shiftAmount )
+{
+    unsigned int newInd, oldInd;
+
+    // shift greater instead if shiftAmount is negative
+    if( shiftAmount < 0 )
+    {
+        digitShiftGreater( -shiftAmount );
+        return;
+    }
+
+    // initial: new = start, old = start + shiftAmount
+    // update: increment both
+    // terminate: old out of upper bound
+    for( newInd = 0, oldInd = shiftAmount; 
+             oldInd < size; 
+                 newInd++, oldInd++ )
+    {
+        // store old value into new position
+        digits[ newInd ] = digits[ oldInd ];
+    }
+
+    // decrement size by shiftAmount (shifting every digit out leaves 0)
+    size = (unsigned int)shiftAmount < size ? size - shiftAmount : 0;
+}
+
+
+void LargeInt::digitShiftGreater( int shiftAmount )
+{
+    int oldInd, oldSize;
+
+    // shift lesser instead if shiftAmount is negative
+    if( shiftAmount < 0 )
+    {
+        digitShiftLesser( -shiftAmount );
+        return;
+    }
+
+    // do nothing if value is 0 (keep size consistent)
+    if( size == 0 )
+    {
+        return;
+    }
+
+    // add shiftAmount to size
+    oldSize = size;
+    resize( oldSize + shiftAmount );
+
+    // initial: old = size - 1
+    // update: old -= 1
+    // terminate: oldInd out of lower bound
+    for( oldInd = oldSize - 1; oldInd >= 0; oldInd-- )
+    {
+        // store old value into new space (new = old + shiftAmount)
+        digits[ oldInd + shiftAmount ] = digits[ oldInd ];
+    }
+
+    // store 0 in remaining spaces
+    for( oldInd = oldInd + shiftAmount; oldInd >= 0; oldInd-- )
+    {
+        digits[ oldInd ] = 0;
+    }
+}
+
+void operator <<= ( LargeInt &toShift, int shiftAmount )
+{
+    unsigned int shiftDigits, shiftBits;
+    LI_Properties::digit::type currentRemainder, nextRemainder;
+    unsigned int digitInd;
+
+    // calculate digits to shift and bits to shift
+    shiftDigits = shiftAmount / LI_Properties::digit::SIZE;
+    shiftBits = shiftAmount % LI_Properties::digit::SIZE;
+
+    // shift by digits
+    toShift.digitShiftGreater( shiftDigits );
+
+    if( shiftBits != 0 )
+    {
+        // add an extra digit to the end (may be removed later if unneeded)
+        toShift.resize( toShift.size + 1 );
+
+        // first digit has remainder 0
+        currentRemainder = 0;
+
+        // shift bits in each digit by bits to shift (skip last)
+        for( digitInd = 0; digitInd < toShift.size; digitInd++ )
+        {
+            nextRemainder = toShift.digits[ digitInd ] >> 
+                            ( LI_Properties::digit::SIZE - shiftBits );
+            toShift.digits[ digitInd ] = currentRemainder + 
+                                         ( toShift.digits[ digitInd ] << shiftBits );
+            currentRemainder = nextRemainder;
+        }
+
+        toShift.removeLeadingZeros();
+    }
+}
+
+void operator >>= ( LargeInt &toShift, int shiftAmount )
+{
+    unsigned int shiftDigits, shiftBits;
+    LI_Properties::digit::type currentRemainder, nextRemainder;
+    int digitInd;
+
+    // calculate digits to shift and bits to shift
+    shiftDigits = shiftAmount / LI_Properties::digit::SIZE;
+    shiftBits = shiftAmount % LI_Properties::digit::SIZE;
+
+    // shift by digits
+    toShift.digitShiftLesser( shiftDigits );
+
+    if( shiftBits != 0 )
+    {
+        // last digit has remainder 0
+        currentRemainder = 0;
+
+        // shift bits in each digit by bits to shift (skip last)
+        for( digitInd = toShift.size - 1; digitInd >= 0; digitInd-- )
+        {
+            nextRemainder = toShift.digits[ digitInd ] << 
+                                 ( LI_Properties::digit::SIZE - shiftBits );
+            toShift.digits[ digitInd ] = ( toShift.digits[ digitInd ] >> shiftBits )
+                                          + currentRemainder;
+            currentRemainder = nextRemainder;
+        }
+
+        // remove leading zeros
+        toShift.removeLeadingZeros();
+    }
+}
+
+
+LargeInt operator<<( LargeInt &toShift, int shiftVal )
+{
+    LargeInt result = toShift;
+    result <<= shiftVal;
+    return result;
+}
+
+LargeInt operator>>( LargeInt &toShift, int shiftVal )
+{
+    LargeInt result = toShift;
+    result >>= shiftVal;
+    return result;
+}
+
+
+
+////////////// adding ///////////////
+LargeInt operator+( const LargeInt &one, const LargeInt &other )
+{
+    return LargeIntView( one ) + LargeIntView( other );
+}
+
+LargeInt operator+( const LargeIntView &one, const LargeIntView &other )
+{
+    LargeInt result;
+    const LargeIntView *greater, *smaller;
+
+    // signs are the same: direct magnitude addition
+    if( one.sign == other.sign )
+    {
+        result = addMagnitude( one, other );
+        result.sign = one.sign;
+        return result;
+    }
+    // different signs
+
+    // identify greater/smaller magnitudes
+    if( spaceshipMagComp( one, other ) >= 0 )
+    {
+        greater = &one;
+        smaller = &other;
+    }
+    else
+    {
+        greater = &other;
+        smaller = &one;
+    }
+
+    // subtract magnitude of smaller from greater
+    result = subtractMagnitude( *greater, *smaller );
+
+    // set result sign to sign of the greater value (zero is never negative)
+    result.sign = greater->sign && result.size != 0;
+
+    return result;
+}
+
+
+// adds magnitude of two LargeInts
+// sign is ignored, and the result sign is positive
+LargeInt addMagnitude( const LargeIntView &one, const LargeIntView &other )
+{
+    LargeInt result = LargeInt();
+    const LargeIntView *larger, *smaller;
+
+    // extract larger/smaller
+    if( one.size >= other.size )
+    {
+        larger = &one;
+        smaller = &other;
+    }
+    else
+    {
+        larger = &other;
+        smaller = &one;
+    }
+
+    // room for one more digit than the larger, for the carry
+    result.reallocate( larger->size + 1 );
+    result.resize( larger->size );
+    if( addDigitArrays( result.digits, larger->digits, larger->size, 
+                        smaller->digits, smaller->size ) )
+    {
+        // (safe due to excessive previous allocation)
+        result.digits[ result.size ] = 1;
+        result.size += 1;
+    }
+
+    return result;
+}
+
+void LargeInt::addDigitAtIndex( LI_Properties::digit::type toAdd, 
+                                unsigned int addIndex )
+{
+    bool remainder;
+    if( size <= addIndex )
+    {
+        // +1 to include index, +1 for possible overflow
+        resize( addIndex + 1 + 1 );
+    }
+    else
+    {
+        // +1 for possible overflow
+        resize( size + 1 );
+    }
+
+    digits[ addIndex ] += toAdd;
+    remainder = digits[ addIndex ] < toAdd;
+    while( remainder )
+    {
+        addIndex++;
+        digits[ addIndex ] += remainder;
+        remainder = digits[ addIndex ] == (LI_Properties::digit::type)0;
+    }
+
+    // remove leading zeros (due to oversizing)
+    removeLeadingZeros();
+}
+
+
+void LargeInt::addMagnitudeAtIndex( const LargeInt &toAdd, 
+                                    unsigned int addIndex )
+{
+    LI_Properties::digit::type remainder;
+
+    // adding 0 has no effect
+    if( toAdd.size == 0 )
+    {
+        return;
+    }
+
+    // extend to cover all of toAdd
+    if( size < addIndex + toAdd.size )
+    {
+        resize( addIndex + toAdd.size );
+    }
+
+    remainder = addDigitArrays( digits + addIndex, digits + addIndex, 
+                                size - addIndex, toAdd.digits, toAdd.size );
+
+    // store remainder past the last digit if necessary
+    if( remainder )
+    {
+        resize( size + 1 );
+        digits[ size - 1 ] = remainder;
+    }
+}
+
+
+// adds the signed value ( valueSign ? -1 : 1 ) * value[ 0 .. valueSize ) in
+// place, only growing the digits when the result needs more space
+// (value must not point into this LargeInt's digits)
+void LargeInt::addSignedDigits( const LI_Properties::digit::type *value, 
+                                unsigned int valueSize, bool valueSign )
+{
+    unsigned int oldSize;
+
+    valueSize = significantSize( value, valueSize );
+    if( valueSize == 0 )
+    {
+        return;
+    }
+    // zero takes the sign of the value
+    if( size == 0 )
+    {
+        sign = valueSign;
+    }
+
+    // signs are the same: add magnitudes, with one digit for the carry
+    if( sign == valueSign )
+    {
+        oldSize = max( size, valueSize );
+        resize( oldSize + 1 );
+        digits[ oldSize ] = addDigitArrays( digits, digits, oldSize, 
+                                            value, valueSize );
+        removeLeadingZeros();
+        return;
+    }
+
+    // different signs: subtract the smaller magnitude from the larger
+    if( compareDigitArrays( digits, size, value, valueSize ) >= 0 )
+    {
+        subtractDigitArrays( digits, digits, size, value, valueSize );
+    }
+    else
+    {
+        // value - this, stored over this (result may be other here, since
+        // every digit is read before it is written)
+        oldSize = size;
+        resize( valueSize );
+        subtractDigitArrays( digits, value, valueSize, digits, oldSize );
+        sign = valueSign;
+    }
+
+    // zero is never negative
+    removeLeadingZeros();
+    sign = sign && size != 0;
+}
+
+LargeInt &LargeInt::operator+=( const LargeIntView &other )
+{
+    // digits of this LargeInt (itself, or a slice of it) would change
+    // while they are read: add a copy
+    if( other.digits >= digits && other.digits < digits + capacity )
+    {
+        LargeInt copy( other );
+        addSignedDigits( copy.digits, copy.size, copy.sign );
+        return *this;
+    }
+    addSignedDigits( other.digits, other.size, other.sign );
+    return *this;
+}
+
+
+////////////// subtracting ///////////////
+
+// returns larger - smaller
+// requirement: first must be greater (or equal) than second
+//  - if not met, undefined behavior
+LargeInt subtractMagnitude( const LargeIntView &larger, const LargeIntView &smaller )
+{
+    LargeInt result = LargeInt();
+
+    // resize to larger's size (reduce later if leading zeros)
+    result.resize( larger.size );
+
+    // (a final borrow would mean invalid input: not handled)
+    subtractDigitArrays( result.digits, larger.digits, larger.size, 
+                         smaller.digits, smaller.size );
+
+    // remove leading zeros
+    result.removeLeadingZeros();
+
+    return result;
+}
+
+LargeInt &LargeInt::operator-=( const LargeIntView &other )
+{
+    // subtracting itself leaves zero (a view of it with the other sign
+    // doubles it, below)
+    if( other.digits == digits && other.size == size && other.sign == sign )
+    {
+        resize( 0 );
+        sign = false;
+        return *this;
+    }
+    // (a slice of this LargeInt's digits is copied, as in +=)
+    if( other.digits >= digits && other.digits < digits + capacity )
+    {
+        LargeInt copy( other );
+        addSignedDigits( copy.digits, copy.size, !copy.sign );
+        return *this;
+    }
+    addSignedDigits( other.digits, other.size, !other.sign );
+    return *this;
+}
+
+LargeInt operator-( const LargeInt &first, const LargeInt &second )
+{
+    return LargeIntView( first ) - LargeIntView( second );
+}
+
+LargeInt operator-( const LargeIntView &first, const LargeIntView &second )
+{
+    LargeInt result;
+
+    // check for diffferent sign
+    if( first.sign != second.sign )
+    {
+        // (second sign is flipped to have same sign)
+        // add magnitude of first/second
+        result = addMagnitude( first, second );
+
+        // set result's sign to first's sign, return
+        result.sign = first.sign;
+        return result;
+    }
+    // otherwise, same sign
+
+    // subtract the smaller magnitude from the larger
+    if( spaceshipMagComp( first, second ) >= 0 )
+    {
+        // result keeps first's sign
+        result = subtractMagnitude( first, second );
+        result.sign = first.sign;
+    }
+    else
+    {
+        // second is larger, so the result has the opposite sign
+        result = subtractMagnitude( second, first );
+        result.sign = !first.sign;
+    }
+
+    // zero is never negative
+    result.sign = result.sign && result.size != 0;
+    return result;
+}
+
+
+////////////// comparing ///////////////
+// returns positive if first is greater, 
+//    negative if second is greater, 
+//    zero if equal
+int spaceshipMagComp( const LargeIntView &first, const LargeIntView &second )
+{
+    int digitIndex;
+
+    // case different size
+    if( first.size != second.size )
+    {
+        // return differnece in sizes
+        return first.size - second.size;
+    }
+    // otherwise, same size
+
+    // iterate over digits (most significant->least)
+    for( digitIndex = first.size - 1; digitIndex >= 0; digitIndex-- )
+    {
+        // end if differnece found
+        if( first.digits[ digitIndex ] != second.digits[ digitIndex ] )
+        {
+            // DO NOT RETURN SUBTRACT: (unsigned integers)
+            if( first.digits[ digitIndex ] > second.digits[ digitIndex ] )
+            {
+                return 1;
+            }
+            return -1;
+        }
+    }
+
+    // return no difference (all digits equal)
+    return 0; 
+}
+
+int spaceshipComp( const LargeIntView &first, const LargeIntView &second )
+{
+    // check signs are different
+    if( first.sign != second.sign )
+    {
+        // first has negative sign
+        if( first.sign )
+        {
+            return -1;
+        }
+        return 1;
+    }
+
+    // set to reverse if negative
+    if( first.sign )
+    {
+        // return reversed magnitude comparison
+        return -spaceshipMagComp( first, second );
+    }
+
+    // return normal comparison
+    return spaceshipMagComp( first, second );
+}
+
+
+
+
+bool operator<=( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) <= 0;
+}
+
+bool operator<=( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) <= 0;
+}
+
+
+bool operator>=( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) >= 0;
+}
+
+bool operator>=( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) >= 0;
+}
+
+
+bool operator>( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) > 0;
+}
+
+bool operator>( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) > 0;
+}
+
+
+bool operator<( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) < 0;
+}
+
+bool operator<( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) < 0;
+}
+
+
+bool operator==( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) == 0;
+}
+
+bool operator==( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) == 0;
+}
+
+
+bool operator!=( const LargeInt &first, const LargeInt &second )
+{
+    return spaceshipComp( first, second ) != 0;
+}
+
+bool operator!=( const LargeIntView &first, const LargeIntView &second )
+{
+    return spaceshipComp( first, second ) != 0;
+}
+
+
+
+///////////// lazy expressions ///////////////
+LI_Properties::digit::type combineExpressionScalars( 
+                                    LI_Properties::digit::type one, 
+                                    LI_Properties::digit::type other )
+{
+    LI_Properties::digit::type low, high;
+
+    multiplyDigits( one, other, low, high );
+    if( high != 0 )
+    {
+        throw std::overflow_error( "expression scalars overflow a digit in "
+                                   "combineExpressionScalars\n" );
+    }
+    return low;
+}
+
+/* evaluateExpressionTerms
+every term is walked together, one result digit at a time:
+ - each term keeps its own shifted-out bits (previous) and multiplication
+   carry, so its digits are read exactly once
+ - the term digits are summed with a signed carry into the result digit
+ - a negative sum is left in two's complement, and negated at the end
+the result has one more digit than the longest term, so the final carry
+is 0 (non-negative) or -1 (negative)
+*/
+void evaluateExpressionTerms( LargeInt &result, LargeIntExpressionTerm *terms, 
+                              unsigned int termCount )
+{
+    LI_Properties::digit::signedDoubleSize::type sum = 0;
+    LI_Properties::digit::doubleSize::type product;
+    LI_Properties::digit::type current, shifted;
+    unsigned int resultSize = 0;
+    unsigned int termInd, index, bitShift;
+    LargeIntExpressionTerm *term;
+
+    // set up each term, skipping zeros
+    for( termInd = 0; termInd < termCount; termInd++ )
+    {
+        term = terms + termInd;
+        term->digits = term->value->digits;
+        term->size = term->value->size;
+        term->negative = term->negative != term->value->sign;
+        term->start = term->shiftBits / LI_Properties::digit::SIZE;
+        term->previous = 0;
+        term->carry = 0;
+        if( term->size == 0 || term->multiplier == 0 )
+        {
+            term->end = 0;
+            continue;
+        }
+        // (one digit for the shifted bits, one for the multiplier)
+        term->end = term->start + term->size + 2;
+        resultSize = max( resultSize, term->end + 1 );
+    }
+
+    result.resize( 0 );
+    result.resize( resultSize );
+
+    for( index = 0; index < resultSize; index++ )
+    {
+        for( termInd = 0; termInd < termCount; termInd++ )
+        {
+            term = terms + termInd;
+            if( index < term->start || index >= term->end )
+            {
+                continue;
+            }
+
+            // digit of value << shiftBits
+            current = index - term->start < term->size ? 
+                      term->digits[ index - term->start ] : 0;
+            bitShift = term->shiftBits % LI_Properties::digit::SIZE;
+            shifted = current;
+            if( bitShift )
+            {
+                shifted = ( current << bitShift ) | 
+                          ( term->previous >> ( LI_Properties::digit::SIZE - bitShift ) );
+            }
+            term->previous = current;
+
+            // times the multiplier
+            product = (LI_Properties::digit::doubleSize::type)shifted * 
+                      term->multiplier + term->carry;
+            term->carry = (LI_Properties::digit::type)( product >> 
+                                                        LI_Properties::digit::SIZE );
+
+            if( term->negative )
+            {
+                sum -= (LI_Properties::digit::type)product;
+            }
+            else
+            {
+                sum += (LI_Properties::digit::type)product;
+            }
+        }
+
+        result.digits[ index ] = (LI_Properties::digit::type)sum;
+        // (arithmetic shift, the carry may be negative)
+        sum >>= LI_Properties::digit::SIZE;
+    }
+
+    // negative: take the two's complement for the magnitude
+    result.sign = sum < 0;
+    if( result.sign )
+    {
+        for( index = 0; index < resultSize; index++ )
+        {
+            result.digits[ index ] = ~result.digits[ index ];
+        }
+        for( index = 0; index < resultSize; index++ )
+        {
+            result.digits[ index ]++;
+            if( result.digits[ index ] != 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    result.removeLeadingZeros();
+    result.sign = result.sign && result.size != 0;
+}
+
+
+
+///////////// multiplication ///////////////
+void operator*=( LargeInt &one, LI_Properties::digit::type other )
+{
+    LI_Properties::digit::type overflow;
+
+    // return '0' if multiplying by 0
+    if( other == 0 )
+    {
+        one = LargeInt( 0 );
+        return;
+    }
+
+    overflow = multiplyDigitArray( one.digits, one.digits, one.size, other );
+    if( overflow )
+    {
+        one.resize( one.size + 1 );
+        one.digits[ one.size - 1 ] = overflow;
+    }
+
+    // set sign if different signs
+    one.sign = one.sign != ( other < 0 );
+}
+
+void operator*=( LargeInt &first, const LargeInt &second )
+{
+    // multiplying by itself is a square
+    if( &first == &second )
+    {
+        first = square( first );
+        return;
+    }
+    first = first * second;
+}
+
+LargeInt operator*( const LargeInt &one, const LI_Properties::digit::type other )
+{
+    LargeInt result = one;
+    result *= other;
+
+    return result;
+}
+
+LargeInt operator*( const LargeInt &one, const LargeInt &other )
+{
+    LargeInt result = LargeInt();
+
+    // multiplying by itself is a square
+    if( &one == &other )
+    {
+        return square( one );
+    }
+
+    result = multiplyLIMagnitude( one, other );
+
+
+    // (negative) sign if different signs, zero is never negative
+    result.sign = one.sign != other.sign && result.size != 0;
+
+    return result;
+}
+
+// multiplies the digits the views refer to directly into the result
+LargeInt operator*( const LargeIntView &one, const LargeIntView &other )
+{
+    LargeInt result;
+
+    if( one.size == 0 || other.size == 0 )
+    {
+        return result;
+    }
+
+    result.resize( one.size + other.size );
+    if( one.size >= other.size )
+    {
+        LI_Limbs::mul( result.digits, one.digits, one.size, 
+                       other.digits, other.size );
+    }
+    else
+    {
+        LI_Limbs::mul( result.digits, other.digits, other.size, 
+                       one.digits, one.size );
+    }
+    result.removeLeadingZeros();
+
+    // (negative) sign if different signs
+    result.sign = one.sign != other.sign;
+    return result;
+}
+
+// adds value * multiplier into result[ 0 ] to result[ size ] (exclusive), 
+// returning the digit carried out of the last position
+static LI_Properties::digit::type addMultipleOfDigitArray( 
+                                    LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size,
+                                    LI_Properties::digit::type multiplier )
+{
+    LI_Properties::digit::doubleSize::type wkgProduct = 0;
+    unsigned int index;
+
+#if defined( LI_X86_64_KERNELS )
+    if( hasMultiplyCarryExtensions && size > 0 )
+    {
+        return addMultipleMulx( result, value, size, multiplier );
+    }
+#endif
+
+    for( index = 0; index < size; index++ )
+    {
+        // (max product + 2 max digits still fits in double size)
+        wkgProduct += (LI_Properties::digit::doubleSize::type)value[ index ] * 
+                      multiplier + 
+                      result[ index ];
+        result[ index ] = (LI_Properties::digit::type)wkgProduct;
+        wkgProduct >>= LI_Properties::digit::SIZE;
+    }
+
+    return (LI_Properties::digit::type)wkgProduct;
+}
+
+// adds ( negate ? -1 : 1 ) * one * other in place
+//  - small products with the same sign as this are accumulated a row at a 
+//    time directly into the digits, with no temporary
+//  - otherwise the product is formed once and added in place
+void LargeInt::addProduct( const LargeInt &one, const LargeInt &other, 
+                           bool negate )
+{
+    bool productSign = ( one.sign != other.sign ) != negate;
+    const LargeInt *larger, *smaller;
+    LI_Properties::digit::type carry;
+    unsigned int rowInd, index;
+    LargeInt product;
+
+    if( one.size == 0 || other.size == 0 )
+    {
+        return;
+    }
+
+    if( this != &one && this != &other && 
+        ( size == 0 || sign == productSign ) &&
+        min( one.size, other.size ) < LI_Properties::multiplication::KARATSUBA_THRESHOLD )
+    {
+        // extract larger/smaller
+        if( one.size >= other.size )
+        {
+            larger = &one;
+            smaller = &other;
+        }
+        else
+        {
+            larger = &other;
+            smaller = &one;
+        }
+
+        // room for the sum, plus one digit for the final carry
+        sign = productSign;
+        resize( max( size, larger->size + smaller->size ) + 1 );
+
+        // add each row, carrying into the digits above it
+        // (the sum fits, so the carry always stops within the digits)
+        for( rowInd = 0; rowInd < smaller->size; rowInd++ )
+        {
+            carry = addMultipleOfDigitArray( digits + rowInd, larger->digits, 
+                                             larger->size, 
+                                             smaller->digits[ rowInd ] );
+            for( index = rowInd + larger->size; carry; index++ )
+            {
+                digits[ index ] += carry;
+                carry = digits[ index ] < carry;
+            }
+        }
+
+        removeLeadingZeros();
+        return;
+    }
+
+    product = multiplyLIMagnitude( one, other );
+    addSignedDigits( product.digits, product.size, productSign );
+}
+
+void LargeInt::addmul( const LargeInt &one, const LargeInt &other )
+{
+    addProduct( one, other, false );
+}
+
+void LargeInt::submul( const LargeInt &one, const LargeInt &other )
+{
+    addProduct( one, other, true );
+}
+
+// stores one * other into result (oneSize + otherSize digits) a row at a time
+// (result must not overlap one or other)
+static void gradeschoolLimbs( LI_Properties::digit::type *result,
+                              const LI_Properties::digit::type *one, 
+                              unsigned int oneSize,
+                              const LI_Properties::digit::type *other, 
+                              unsigned int otherSize )
+{
+    unsigned int index;
+
+    // clear the digits the first row accumulates into
+    for( index = 0; index < oneSize; index++ )
+    {
+        result[ index ] = 0;
+    }
+
+    // add one * other[ index ] at offset index, the carry is the row's top
+    for( index = 0; index < otherSize; index++ )
+    {
+        result[ oneSize + index ] = addMultipleOfDigitArray( result + index, 
+                                                             one, oneSize,
+                                                             other[ index ] );
+    }
+}
+
+// scratch digits needed by karatsubaLimbs when the larger operand has size
+// each level uses 4 * (half + 1) digits, and recurses on at most half + 1 digits
+static unsigned int karatsubaScratchSize( unsigned int size )
+{
+    unsigned int total = 0;
+    unsigned int halfSize;
+
+    while( size >= LI_Properties::multiplication::KARATSUBA_THRESHOLD )
+    {
+        halfSize = ( size + 1 ) / 2;
+        total += 4 * ( halfSize + 1 );
+        size = halfSize + 1;
+    }
+    return total;
+}
+
+/* karatsubaLimbs
+stores one * other into result (oneSize + otherSize digits)
+
+balanced operands are split at half of the larger size:
+   one = oneHigh * B^half + oneLow, other = otherHigh * B^half + otherLow
+   low = oneLow * otherLow, high = oneHigh * otherHigh
+   middle = (oneLow + oneHigh) * (otherLow + otherHigh) - low - high
+   one * other = high * B^(2*half) + middle * B^half + low
+unbalanced operands (the smaller fits in half of the larger) are multiplied
+in blocks of the smaller size, adding each block product into the result
+
+Requirements:
+ - result must not overlap one or other
+ - scratch must have karatsubaScratchSize( min( larger, 2 * smaller ) ) digits,
+   for the larger and smaller of oneSize and otherSize (unbalanced operands
+   only recurse on blocks of the smaller size)
+*/
+static void karatsubaLimbs( LI_Properties::digit::type *result,
+                            const LI_Properties::digit::type *one, 
+                            unsigned int oneSize,
+                            const LI_Properties::digit::type *other, 
+                            unsigned int otherSize,
+                            LI_Properties::digit::type *scratch )
+{
+    unsigned int fullSize = oneSize + otherSize;
+    unsigned int index;
+
+    // ignore leading zeros (the top of result is cleared instead)
+    oneSize = significantSize( one, oneSize );
+    otherSize = significantSize( other, otherSize );
+    for( index = oneSize + otherSize; index < fullSize; index++ )
+    {
+        result[ index ] = 0;
+    }
+
+    // keep one as the larger operand
+    if( oneSize < otherSize )
+    {
+        std::swap( one, other );
+        std::swap( oneSize, otherSize );
+    }
+
+    // terminate recursion for small operands
+    if( otherSize < LI_Properties::multiplication::KARATSUBA_THRESHOLD )
+    {
+        gradeschoolLimbs( result, one, oneSize, other, otherSize );
+        return;
+    }
+
+    unsigned int halfSize = ( oneSize + 1 ) / 2;
+
+    // unbalanced: multiply one in blocks of otherSize digits
+    if( otherSize <= halfSize )
+    {
+        LI_Properties::digit::type *blockProduct = scratch;
+        unsigned int blockStart, blockSize;
+
+        // first block is stored directly, clear the remainder of the result
+        karatsubaLimbs( result, one, otherSize, other, otherSize, 
+                        scratch + 2 * otherSize );
+        for( index = 2 * otherSize; index < oneSize + otherSize; index++ )
+        {
+            result[ index ] = 0;
+        }
+
+        // add remaining blocks at their offsets
+        for( blockStart = otherSize; blockStart < oneSize; 
+                                     blockStart += otherSize )
+        {
+            blockSize = min( otherSize, oneSize - blockStart );
+            karatsubaLimbs( blockProduct, one + blockStart, blockSize, 
+                            other, otherSize, scratch + 2 * otherSize );
+            addDigitArrays( result + blockStart, 
+                            result + blockStart, oneSize + otherSize - blockStart,
+                            blockProduct, blockSize + otherSize );
+        }
+        return;
+    }
+
+    // balanced: both high halves are non-empty
+    unsigned int oneHighSize = oneSize - halfSize;
+    unsigned int otherHighSize = otherSize - halfSize;
+    unsigned int middleSize = min( 2 * halfSize + 2, 
+                                   oneSize + otherSize - halfSize );
+    LI_Properties::digit::type *oneSum = scratch;
+    LI_Properties::digit::type *otherSum = oneSum + halfSize + 1;
+    LI_Properties::digit::type *middle = otherSum + halfSize + 1;
+    LI_Properties::digit::type *nextScratch = middle + 2 * halfSize + 2;
+
+    // low and high products are stored in place
+    karatsubaLimbs( result, one, halfSize, other, halfSize, nextScratch );
+    karatsubaLimbs( result + 2 * halfSize, one + halfSize, oneHighSize,
+                    other + halfSize, otherHighSize, nextScratch );
+
+    // middle = (oneLow + oneHigh) * (otherLow + otherHigh) - low - high
+    oneSum[ halfSize ] = addDigitArrays( oneSum, one, halfSize, 
+                                         one + halfSize, oneHighSize );
+    otherSum[ halfSize ] = addDigitArrays( otherSum, other, halfSize,
+                                           other + halfSize, otherHighSize );
+    karatsubaLimbs( middle, oneSum, halfSize + 1, otherSum, halfSize + 1, 
+                    nextScratch );
+    subtractDigitArrays( middle, middle, 2 * halfSize + 2, 
+                         result, 2 * halfSize );
+    subtractDigitArrays( middle, middle, 2 * halfSize + 2, 
+                         result + 2 * halfSize, oneHighSize + otherHighSize );
+
+    // add middle at halfSize (digits past middleSize are zero)
+    addDigitArrays( result + halfSize, result + halfSize, 
+                    oneSize + otherSize - halfSize, middle, middleSize );
+}
+
+/* gradeschoolSquareLimbs
+stores value^2 into result (2 * size digits)
+each cross product value[i] * value[j] (i < j) appears twice in the square,
+so only those are accumulated, then doubled, then the diagonal squares added
+(result must not overlap value)
+*/
+static void gradeschoolSquareLimbs( LI_Properties::digit::type *result,
+                                    const LI_Properties::digit::type *value, 
+                                    unsigned int size )
+{
+    LI_Properties::digit::doubleSize::type wkgProduct;
+    LI_Properties::digit::type topBit, nextTopBit;
+    unsigned int rowInd;
+
+    // clear result, rows are accumulated into it
+    for( rowInd = 0; rowInd < 2 * size; rowInd++ )
+    {
+        result[ rowInd ] = 0;
+    }
+
+    // cross products above the diagonal
+    for( rowInd = 0; rowInd + 1 < size; rowInd++ )
+    {
+        result[ rowInd + size ] = addMultipleOfDigitArray( 
+                                      result + 2 * rowInd + 1, 
+                                      value + rowInd + 1, size - rowInd - 1,
+                                      value[ rowInd ] );
+    }
+
+    // double the cross products (shift left by one bit)
+    topBit = 0;
+    for( rowInd = 0; rowInd < 2 * size; rowInd++ )
+    {
+        nextTopBit = result[ rowInd ] >> ( LI_Properties::digit::SIZE - 1 );
+        result[ rowInd ] = ( result[ rowInd ] << 1 ) | topBit;
+        topBit = nextTopBit;
+    }
+
+    // add the diagonal squares value[i]^2 at digit 2*i
+    wkgProduct = 0;
+    for( rowInd = 0; rowInd < size; rowInd++ )
+    {
+        wkgProduct += (LI_Properties::digit::doubleSize::type)value[ rowInd ] * 
+                      value[ rowInd ];
+        wkgProduct += result[ 2 * rowInd ];
+        result[ 2 * rowInd ] = (LI_Properties::digit::type)wkgProduct;
+        wkgProduct >>= LI_Properties::digit::SIZE;
+        wkgProduct += result[ 2 * rowInd + 1 ];
+        result[ 2 * rowInd + 1 ] = (LI_Properties::digit::type)wkgProduct;
+        wkgProduct >>= LI_Properties::digit::SIZE;
+    }
+}
+
+/* karatsubaSquareLimbs
+stores value^2 into result (2 * size digits), with value split at half:
+   value^2 = high^2 * B^(2*half) + middle * B^half + low^2
+   middle = (low + high)^2 - low^2 - high^2
+Requirements:
+ - result must not overlap value
+ - scratch must have karatsubaScratchSize( size ) digits
+*/
+static void karatsubaSquareLimbs( LI_Properties::digit::type *result,
+                                  const LI_Properties::digit::type *value, 
+                                  unsigned int size,
+                                  LI_Properties::digit::type *scratch )
+{
+    unsigned int fullSize = 2 * size;
+    unsigned int index;
+
+    // ignore leading zeros (the top of result is cleared instead)
+    size = significantSize( value, size );
+    for( index = 2 * size; index < fullSize; index++ )
+    {
+        result[ index ] = 0;
+    }
+
+    // terminate recursion for small values
+    if( size < LI_Properties::multiplication::KARATSUBA_THRESHOLD )
+    {
+        gradeschoolSquareLimbs( result, value, size );
+        return;
+    }
+
+    unsigned int halfSize = ( size + 1 ) / 2;
+    unsigned int highSize = size - halfSize;
+    unsigned int middleSize = min( 2 * halfSize + 2, 2 * size - halfSize );
+    LI_Properties::digit::type *sum = scratch;
+    LI_Properties::digit::type *middle = sum + halfSize + 1;
+    LI_Properties::digit::type *nextScratch = middle + 2 * halfSize + 2;
+
+    // low and high squares are stored in place
+    karatsubaSquareLimbs( result, value, halfSize, nextScratch );
+    karatsubaSquareLimbs( result + 2 * halfSize, value + halfSize, highSize, 
+                          nextScratch );
+
+    // middle = (low + high)^2 - low^2 - high^2
+    sum[ halfSize ] = addDigitArrays( sum, value, halfSize, 
+                                      value + halfSize, highSize );
+    karatsubaSquareLimbs( middle, sum, halfSize + 1, nextScratch );
+    subtractDigitArrays( middle, middle, 2 * halfSize + 2, 
+                         result, 2 * halfSize );
+    subtractDigitArrays( middle, middle, 2 * halfSize + 2, 
+                         result + 2 * halfSize, 2 * highSize );
+
+    // add middle at halfSize (digits past middleSize are zero)
+    addDigitArrays( result + halfSize, result + halfSize, 
+                    2 * size - halfSize, middle, middleSize );
+}
+
+////////////// number theoretic transform ///////////////
+// products are computed as convolutions of the 32 bit words of the digit
+// arrays modulo three primes of the form k * 2^n + 1, then recombined with the
+// chinese remainder theorem. the primes multiply to ~2^91, which exceeds the
+// largest convolution coefficient ( min size * (2^32 - 1)^2 ) for any product
+// of up to 2^26 words (limited by the smallest 2^n)
+const uint32_t NTT_PRIME_ONE = 2013265921; // 15 * 2^27 + 1, primitive root 31
+const uint32_t NTT_PRIME_TWO = 469762049; // 7 * 2^26 + 1, primitive root 3
+const uint32_t NTT_PRIME_THREE = 3221225473u; // 3 * 2^30 + 1, primitive root 5
+
+template <uint32_t Modulus>
+static uint32_t modularPower( uint32_t base, uint64_t power )
+{
+    uint64_t result = 1;
+    uint64_t wkgBase = base % Modulus;
+
+    // square and multiply, least significant bit first
+    while( power )
+    {
+        if( power & 1 )
+        {
+            result = result * wkgBase % Modulus;
+        }
+        wkgBase = wkgBase * wkgBase % Modulus;
+        power >>= 1;
+    }
+    return (uint32_t)result;
+}
+
+// stores root^index into roots[ index ] for index < count
+template <uint32_t Modulus>
+static void fillRootPowers( uint32_t *roots, unsigned int count, uint32_t root )
+{
+    unsigned int index;
+    uint64_t wkgPower = 1;
+
+    for( index = 0; index < count; index++ )
+    {
+        roots[ index ] = (uint32_t)wkgPower;
+        wkgPower = wkgPower * root % Modulus;
+    }
+}
+
+// butterflies first to last (exclusive) of a forward transform stage, counted
+// across its blocks of length values (each block has length/2 butterflies)
+template <uint32_t Modulus>
+static void forwardButterflies( uint32_t *values, unsigned int length, 
+                                unsigned int stride, const uint32_t *roots,
+                                unsigned int first, unsigned int last )
+{
+    unsigned int halfLength = length / 2;
+    unsigned int start = first / halfLength * length;
+    unsigned int index = first % halfLength;
+    unsigned int end;
+    uint32_t upper, lower;
+
+    for( ; first < last; start += length, index = 0 )
+    {
+        end = min( halfLength, index + ( last - first ) );
+        first += end - index;
+        for( ; index < end; index++ )
+        {
+            upper = values[ start + index ];
+            lower = values[ start + index + halfLength ];
+            values[ start + index ] = (uint32_t)
+                ( ( (uint64_t)upper + lower ) % Modulus );
+
+            // (reduce the difference first, the largest prime is > 2^31)
+            upper = upper >= lower ? upper - lower : upper + ( Modulus - lower );
+            values[ start + index + halfLength ] = (uint32_t)
+                ( (uint64_t)upper * roots[ index * stride ] % Modulus );
+        }
+    }
+}
+
+/* forwardTransform
+decimation in frequency: natural order input, bit reversed order output
+(the pointwise product does not depend on order, so no reordering is needed)
+roots[ index ] must hold w^index for index < size/2, w a size'th root of unity
+the butterflies of a stage are independent, so each stage may run in parallel
+*/
+template <uint32_t Modulus>
+static void forwardTransform( uint32_t *values, unsigned int size, 
+                              const uint32_t *roots )
+{
+    unsigned int length, stride;
+
+    for( length = size, stride = 1; length >= 2; length >>= 1, stride <<= 1 )
+    {
+        parallelRanges( size / 2, LI_Properties::multiplication::NTT_PARALLEL_GRAIN,
+                        [=]( unsigned int first, unsigned int last )
+                        {
+                            forwardButterflies<Modulus>( values, length, stride, 
+                                                         roots, first, last );
+                        } );
+    }
+}
+
+// butterflies first to last (exclusive) of an inverse transform stage, as in
+// forwardButterflies
+template <uint32_t Modulus>
+static void inverseButterflies( uint32_t *values, unsigned int length, 
+                                unsigned int stride, const uint32_t *roots,
+                                unsigned int first, unsigned int last )
+{
+    unsigned int halfLength = length / 2;
+    unsigned int start = first / halfLength * length;
+    unsigned int index = first % halfLength;
+    unsigned int end;
+    uint32_t upper, lower;
+
+    for( ; first < last; start += length, index = 0 )
+    {
+        end = min( halfLength, index + ( last - first ) );
+        first += end - index;
+        for( ; index < end; index++ )
+        {
+            upper = values[ start + index ];
+            lower = (uint32_t)( (uint64_t)values[ start + index + halfLength ] *
+                                roots[ index * stride ] % Modulus );
+            values[ start + index ] = (uint32_t)
+                ( ( (uint64_t)upper + lower ) % Modulus );
+            values[ start + index + halfLength ] = (uint32_t)
+                ( ( (uint64_t)upper + Modulus - lower ) % Modulus );
+        }
+    }
+}
+
+/* inverseTransform
+decimation in time: bit reversed order input, natural order output
+roots[ index ] must hold w^-index for index < size/2
+(the result is scaled by size, which the caller removes)
+*/
+template <uint32_t Modulus>
+static void inverseTransform( uint32_t *values, unsigned int size, 
+                              const uint32_t *roots )
+{
+    unsigned int length, stride;
+
+    for( length = 2, stride = size / 2; length <= size; length <<= 1, stride >>= 1 )
+    {
+        parallelRanges( size / 2, LI_Properties::multiplication::NTT_PARALLEL_GRAIN,
+                        [=]( unsigned int first, unsigned int last )
+                        {
+                            inverseButterflies<Modulus>( values, length, stride, 
+                                                         roots, first, last );
+                        } );
+    }
+}
+
+/* convolveModulo
+stores the cyclic convolution of one and other modulo Modulus into residues
+(one and other may be the same array, which skips the second transform)
+ - residues and otherResidues must have space for size values
+ - roots must have space for size/2 values
+ - size must be a power of two no greater than the 2-adic order of Modulus - 1
+*/
+template <uint32_t Modulus, uint32_t PrimitiveRoot>
+static void convolveModulo( uint32_t *residues, 
+                            const uint32_t *one, unsigned int oneSize,
+                            const uint32_t *other, unsigned int otherSize,
+                            unsigned int size,
+                            uint32_t *otherResidues, uint32_t *roots )
+{
+    uint32_t root = modularPower<Modulus>( PrimitiveRoot, ( Modulus - 1 ) / size );
+    uint32_t sizeInverse = modularPower<Modulus>( size, Modulus - 2 );
+    unsigned int index;
+
+    bool squaring = one == other && oneSize == otherSize;
+
+    // reduce words modulo the prime, padding with zeros
+    for( index = 0; index < size; index++ )
+    {
+        residues[ index ] = index < oneSize ? one[ index ] % Modulus : 0;
+    }
+    fillRootPowers<Modulus>( roots, size / 2, root );
+    forwardTransform<Modulus>( residues, size, roots );
+
+    // a square only needs one forward transform
+    if( squaring )
+    {
+        otherResidues = residues;
+    }
+    else
+    {
+        for( index = 0; index < size; index++ )
+        {
+            otherResidues[ index ] = index < otherSize ? 
+                                     other[ index ] % Modulus : 0;
+        }
+        forwardTransform<Modulus>( otherResidues, size, roots );
+    }
+
+    // pointwise product, removing the size scaling of the inverse transform
+    parallelRanges( size, LI_Properties::multiplication::NTT_PARALLEL_GRAIN,
+                    [=]( unsigned int first, unsigned int last )
+                    {
+                        for( unsigned int pointInd = first; pointInd < last; pointInd++ )
+                        {
+                            residues[ pointInd ] = (uint32_t)
+                                ( (uint64_t)residues[ pointInd ] * 
+                                  otherResidues[ pointInd ] % Modulus *
+                                  sizeInverse % Modulus );
+                        }
+                    } );
+
+    // transform back using the inverse root
+    fillRootPowers<Modulus>( roots, size / 2, 
+                             modularPower<Modulus>( root, Modulus - 2 ) );
+    inverseTransform<Modulus>( residues, size, roots );
+}
+
+// splits size digits into 32 bit words, least significant first
+static void digitsToWords( uint32_t *words, const LI_Properties::digit::type *digits,
+                           unsigned int size )
+{
+    const unsigned int wordsPerDigit = LI_Properties::digit::SIZE / 32;
+    unsigned int index, wordInd;
+
+    for( index = 0; index < size; index++ )
+    {
+        for( wordInd = 0; wordInd < wordsPerDigit; wordInd++ )
+        {
+            words[ index * wordsPerDigit + wordInd ] = 
+                (uint32_t)( digits[ index ] >> ( 32 * wordInd ) );
+        }
+    }
+}
+
+// joins 32 bit words back into size digits
+static void wordsToDigits( LI_Properties::digit::type *digits, const uint32_t *words,
+                           unsigned int size )
+{
+    const unsigned int wordsPerDigit = LI_Properties::digit::SIZE / 32;
+    unsigned int index, wordInd;
+
+    for( index = 0; index < size; index++ )
+    {
+        digits[ index ] = 0;
+        for( wordInd = 0; wordInd < wordsPerDigit; wordInd++ )
+        {
+            digits[ index ] |= (LI_Properties::digit::type)
+                               words[ index * wordsPerDigit + wordInd ] << ( 32 * wordInd );
+        }
+    }
+}
+
+/* nttLimbs
+stores one * other into result (oneSize + otherSize digits)
+
+the transform works on 32 bit words (wider digits are split into words and
+the product words joined back into digits); each coefficient is recombined from its residues r1, r2, r3 (Garner's method):
+   x12 = r1 + p1 * ( (r2 - r1) / p1 mod p2 )                 (< p1*p2)
+   x   = x12 + p1*p2 * ( (r3 - x12) / (p1*p2) mod p3 )        (< p1*p2*p3)
+and added into a running carry, emitting one word per coefficient
+
+Requirements:
+ - result must not overlap one or other
+ - oneSize + otherSize must be no greater than NTT_MAX_SIZE
+*/
+static void nttLimbs( LI_Properties::digit::type *result,
+                      const LI_Properties::digit::type *one, 
+                      unsigned int oneSize,
+                      const LI_Properties::digit::type *other, 
+                      unsigned int otherSize )
+{
+    const uint64_t primeProduct = (uint64_t)NTT_PRIME_ONE * NTT_PRIME_TWO;
+    const uint32_t oneInverseTwo = 
+               modularPower<NTT_PRIME_TWO>( NTT_PRIME_ONE, NTT_PRIME_TWO - 2 );
+    const uint32_t productInverseThree = 
+               modularPower<NTT_PRIME_THREE>( (uint32_t)( primeProduct % NTT_PRIME_THREE ), 
+                                              NTT_PRIME_THREE - 2 );
+    const unsigned int wordsPerDigit = LI_Properties::digit::SIZE / 32;
+    unsigned int oneWordSize = oneSize * wordsPerDigit;
+    unsigned int otherWordSize = otherSize * wordsPerDigit;
+    unsigned int size = 1;
+    unsigned int index;
+    uint32_t *oneWords, *otherWords, *resultWords;
+    uint32_t *residuesOne, *residuesTwo, *residuesThree, *wkgResidues, *roots;
+    LargeIntScratchScope scratch;
+    uint64_t lowerProduct, upperProduct, lowerSum, carry;
+    uint64_t combined;
+    uint32_t mixed;
+
+    // split the digits into words (a square keeps one array)
+    oneWords = scratch.allocate<uint32_t>( oneWordSize );
+    digitsToWords( oneWords, one, oneSize );
+    otherWords = oneWords;
+    if( one != other || oneSize != otherSize )
+    {
+        otherWords = scratch.allocate<uint32_t>( otherWordSize );
+        digitsToWords( otherWords, other, otherSize );
+    }
+    resultWords = scratch.allocate<uint32_t>( oneWordSize + otherWordSize );
+
+    // transform size: power of two holding the full convolution
+    while( size < oneWordSize + otherWordSize - 1 )
+    {
+        size <<= 1;
+    }
+
+    residuesOne = scratch.allocate<uint32_t>( size );
+    residuesTwo = scratch.allocate<uint32_t>( size );
+    residuesThree = scratch.allocate<uint32_t>( size );
+    wkgResidues = scratch.allocate<uint32_t>( size );
+    roots = scratch.allocate<uint32_t>( size / 2 + 1 );
+
+    if( runsInParallel() )
+    {
+        // the convolutions are independent: the second and third run as tasks,
+        // each with its own working arrays
+        LargeIntTaskGroup group;
+        uint32_t *wkgResiduesTwo = scratch.allocate<uint32_t>( size );
+        uint32_t *rootsTwo = scratch.allocate<uint32_t>( size / 2 + 1 );
+        uint32_t *wkgResiduesThree = scratch.allocate<uint32_t>( size );
+        uint32_t *rootsThree = scratch.allocate<uint32_t>( size / 2 + 1 );
+
+        group.run( [=]
+        {
+            convolveModulo<NTT_PRIME_TWO, 3>( residuesTwo, oneWords, oneWordSize, 
+                                              otherWords, otherWordSize,
+                                              size, wkgResiduesTwo, rootsTwo );
+        } );
+        group.run( [=]
+        {
+            convolveModulo<NTT_PRIME_THREE, 5>( residuesThree, oneWords, oneWordSize, 
+                                                otherWords, otherWordSize,
+                                                size, wkgResiduesThree, rootsThree );
+        } );
+        convolveModulo<NTT_PRIME_ONE, 31>( residuesOne, oneWords, oneWordSize, 
+                                           otherWords, otherWordSize,
+                                           size, wkgResidues, roots );
+        group.wait();
+    }
+    else
+    {
+        convolveModulo<NTT_PRIME_ONE, 31>( residuesOne, oneWords, oneWordSize, 
+                                           otherWords, otherWordSize,
+                                           size, wkgResidues, roots );
+        convolveModulo<NTT_PRIME_TWO, 3>( residuesTwo, oneWords, oneWordSize, 
+                                          otherWords, otherWordSize,
+                                          size, wkgResidues, roots );
+        convolveModulo<NTT_PRIME_THREE, 5>( residuesThree, oneWords, oneWordSize, 
+                                            otherWords, otherWordSize,
+                                            size, wkgResidues, roots );
+    }
+
+    carry = 0;
+    for( index = 0; index < oneWordSize + otherWordSize; index++ )
+    {
+        if( index < oneWordSize + otherWordSize - 1 )
+        {
+            // combine first two residues: x12 = r1 + p1 * mixed
+            mixed = (uint32_t)( ( (uint64_t)residuesTwo[ index ] + NTT_PRIME_TWO - 
+                                  residuesOne[ index ] % NTT_PRIME_TWO ) *
+                                oneInverseTwo % NTT_PRIME_TWO );
+            combined = residuesOne[ index ] + (uint64_t)NTT_PRIME_ONE * mixed;
+
+            // third residue: x = x12 + p1*p2 * mixed
+            mixed = (uint32_t)( ( (uint64_t)residuesThree[ index ] + NTT_PRIME_THREE - 
+                                  combined % NTT_PRIME_THREE ) *
+                                productInverseThree % NTT_PRIME_THREE );
+        }
+        else
+        {
+            // past the last coefficient, only the carry remains
+            combined = 0;
+            mixed = 0;
+        }
+
+        // add x into carry one 32 bit word at a time, emit the lowest word
+        lowerProduct = ( primeProduct & 0xFFFFFFFF ) * mixed;
+        upperProduct = ( primeProduct >> 32 ) * mixed;
+        lowerSum = ( combined & 0xFFFFFFFF ) + ( lowerProduct & 0xFFFFFFFF ) + 
+                   ( carry & 0xFFFFFFFF );
+        resultWords[ index ] = (uint32_t)lowerSum;
+        carry = ( lowerSum >> 32 ) + ( combined >> 32 ) + ( lowerProduct >> 32 ) +
+                ( upperProduct & 0xFFFFFFFF ) + ( carry >> 32 ) + 
+                ( ( upperProduct >> 32 ) << 32 );
+    }
+
+    wordsToDigits( result, resultWords, oneSize + otherSize );
+}
+
+// true if operands of these sizes are multiplied with the NTT
+static bool usesNumberTheoreticTransform( unsigned int oneSize, unsigned int otherSize )
+{
+    return min( oneSize, otherSize ) >= LI_Properties::multiplication::NTT_THRESHOLD &&
+           oneSize + otherSize <= LI_Properties::multiplication::NTT_MAX_SIZE;
+}
+
+LargeInt multiplyLIMagnitude( const LargeInt &one, const LargeInt &other )
+{
+    LargeInt result;
+
+    // multiplying by itself is a square
+    if( &one == &other )
+    {
+        return squareLIMagnitude( one );
+    }
+
+    // case size is one or zero (terminate recursion)
+        // case zero
+            // return 0
+        // case one
+            // digit multiplication
+    if( one.size <= 1 )
+    {
+        if( one.size == 0 )
+        {
+            return LargeInt( 0 );
+        }
+        return other * one.digits[ 0 ];
+    }
+    if( other.size <= 1 )
+    {
+        if( other.size == 0 )
+        {
+            return LargeInt( 0 );
+        }
+        return one * other.digits[ 0 ];
+    }
+
+    // Toom-3/4 (and blocks of them) work on LargeInts, everything else
+    // multiplies the digit arrays directly
+    if( min( one.size, other.size ) >= 
+            LI_Properties::multiplication::TOOM3_THRESHOLD &&
+        !usesNumberTheoreticTransform( one.size, other.size ) )
+    {
+        // Toom splits evenly, so multiply unbalanced operands in blocks
+        if( 2 * one.size <= other.size )
+        {
+            return blockMagMult( other, one );
+        }
+        if( 2 * other.size <= one.size )
+        {
+            return blockMagMult( one, other );
+        }
+        if( min( one.size, other.size ) >= 
+            LI_Properties::multiplication::TOOM4_THRESHOLD )
+        {
+            return toom4MagMult( one, other );
+        }
+        return toom3MagMult( one, other );
+    }
+
+    result.resize( one.size + other.size );
+    if( one.size >= other.size )
+    {
+        LI_Limbs::mul( result.digits, one.digits, one.size, 
+                       other.digits, other.size );
+    }
+    else
+    {
+        LI_Limbs::mul( result.digits, other.digits, other.size, 
+                       one.digits, one.size );
+    }
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+LargeInt gradeschoolMagMult( const LargeInt &one, const LargeInt &other )
+{
+    LargeInt result;
+    const LargeInt *larger, *smaller;
+
+    if( one.size >= other.size )
+    {
+        larger = &one;
+        smaller = &other;
+    }
+    else
+    {
+        larger = &other;
+        smaller = &one;
+    }
+
+    // single allocation: each row (larger * a digit of smaller) is
+    // accumulated directly into the result digits
+    result.resize( larger->size + smaller->size );
+    gradeschoolLimbs( result.digits, larger->digits, larger->size, 
+                      smaller->digits, smaller->size );
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+LargeInt square( const LargeInt &value )
+{
+    // (a square is never negative)
+    return squareLIMagnitude( value );
+}
+
+LargeInt squareLIMagnitude( const LargeInt &value )
+{
+    LargeInt result;
+
+    // case size is one or zero
+    if( value.size <= 1 )
+    {
+        if( value.size == 0 )
+        {
+            return LargeInt( 0 );
+        }
+        result = value * value.digits[ 0 ];
+        result.sign = false;
+        return result;
+    }
+
+    // same tiers as multiplyLIMagnitude, using the squaring kernels
+    if( value.size >= LI_Properties::multiplication::NTT_THRESHOLD &&
+        2 * value.size <= LI_Properties::multiplication::NTT_MAX_SIZE )
+    {
+        result.resize( 2 * value.size );
+        nttLimbs( result.digits, value.digits, value.size, 
+                  value.digits, value.size );
+        result.removeLeadingZeros();
+        return result;
+    }
+    if( value.size >= LI_Properties::multiplication::TOOM4_THRESHOLD )
+    {
+        return toom4MagMult( value, value );
+    }
+    if( value.size >= LI_Properties::multiplication::TOOM3_THRESHOLD )
+    {
+        return toom3MagMult( value, value );
+    }
+
+    // Karatsuba and gradeschool squares work on the digit arrays directly
+    LargeIntScratchScope scratch;
+    result.resize( 2 * value.size );
+    karatsubaSquareLimbs( result.digits, value.digits, value.size, 
+                          scratch.allocate<LI_Properties::digit::type>( 
+                              karatsubaScratchSize( value.size ) ) );
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+// multiplies larger by smaller in blocks of smaller's size
+// (used when the operands are too unbalanced to split evenly)
+LargeInt blockMagMult( const LargeInt &larger, const LargeInt &smaller )
+{
+    LargeInt result;
+    unsigned int blockStart;
+
+    result.reallocate( larger.size + smaller.size + 1 );
+
+    // add each block product at the block's offset
+    for( blockStart = 0; blockStart < larger.size; blockStart += smaller.size )
+    {
+        result.addMagnitudeAtIndex( 
+                   multiplyLIMagnitude( larger.digitSlice( blockStart, smaller.size ),
+                                        smaller ),
+                   blockStart );
+    }
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+// products[ index ] = oneValues[ index ] * otherValues[ index ] for index <
+// count (squares if otherValues is NULL); the products of operands with
+// operandSize digits run as parallel tasks above the parallel threshold
+static void multiplyValues( LargeInt *products, const LargeInt *oneValues, 
+                            const LargeInt *otherValues, unsigned int count, 
+                            unsigned int operandSize )
+{
+    LargeIntTaskGroup group;
+    unsigned int index;
+
+    if( operandSize < LI_Properties::multiplication::PARALLEL_THRESHOLD || 
+        !runsInParallel() )
+    {
+        for( index = 0; index < count; index++ )
+        {
+            products[ index ] = otherValues == NULL ? square( oneValues[ index ] ) :
+                                oneValues[ index ] * otherValues[ index ];
+        }
+        return;
+    }
+
+    // (each task writes only its own product)
+    for( index = 0; index < count; index++ )
+    {
+        group.run( [products, oneValues, otherValues, index]
+        {
+            products[ index ] = otherValues == NULL ? square( oneValues[ index ] ) :
+                                oneValues[ index ] * otherValues[ index ];
+        } );
+    }
+    group.wait();
+}
+
+// evaluates x2*B^2 + x1*B + x0 at B = 0, 1, -1, 2, infinity
+static void toom3Evaluate( const LargeInt pieces[ 3 ], LargeInt values[ 5 ] )
+{
+    values[ 0 ] = pieces[ 0 ];
+
+    // 1, -1 and 2: each a single pass over the pieces
+    values[ 1 ] = lazy( pieces[ 0 ] ) + pieces[ 2 ] + pieces[ 1 ];
+    values[ 2 ] = lazy( pieces[ 0 ] ) + pieces[ 2 ] - pieces[ 1 ];
+    values[ 3 ] = ( lazy( pieces[ 2 ] ) << 2 ) + ( lazy( pieces[ 1 ] ) << 1 ) + 
+                  pieces[ 0 ];
+
+    values[ 4 ] = pieces[ 2 ];
+}
+
+// evaluates x3*B^3 + x2*B^2 + x1*B + x0 at B = 0, 1, -1, 2, -2, 3, infinity
+static void toom4Evaluate( const LargeInt pieces[ 4 ], LargeInt values[ 7 ] )
+{
+    values[ 0 ] = pieces[ 0 ];
+
+    // 1 and -1: even terms x0 + x2, odd terms x1 + x3
+    values[ 1 ] = lazy( pieces[ 0 ] ) + pieces[ 2 ] + pieces[ 1 ] + pieces[ 3 ];
+    values[ 2 ] = lazy( pieces[ 0 ] ) + pieces[ 2 ] - pieces[ 1 ] - pieces[ 3 ];
+
+    // 2 and -2: even terms x0 + 4*x2, odd terms 2*x1 + 8*x3
+    values[ 3 ] = lazy( pieces[ 0 ] ) + ( lazy( pieces[ 2 ] ) << 2 ) + 
+                  ( lazy( pieces[ 1 ] ) << 1 ) + ( lazy( pieces[ 3 ] ) << 3 );
+    values[ 4 ] = lazy( pieces[ 0 ] ) + ( lazy( pieces[ 2 ] ) << 2 ) - 
+                  ( lazy( pieces[ 1 ] ) << 1 ) - ( lazy( pieces[ 3 ] ) << 3 );
+
+    // 3: x0 + 3*x1 + 9*x2 + 27*x3
+    values[ 5 ] = lazy( pieces[ 0 ] ) + lazy( pieces[ 1 ] ) * 3 + 
+                  lazy( pieces[ 2 ] ) * 9 + lazy( pieces[ 3 ] ) * 27;
+
+    values[ 6 ] = pieces[ 3 ];
+}
+
+/* toom3MagMult
+splits both operands into 3 pieces of pieceSize digits, as polynomials in
+B = <digit max + 1>^pieceSize:
+   one = one2*B^2 + one1*B + one0
+
+the product polynomial (degree 4) is evaluated at 0, 1, -1, 2, infinity with
+5 recursive multiplications (squares if one and other are the same object),
+then interpolated:
+   c0 = r(0), c4 = r(inf)
+   c2 = (r(1) + r(-1))/2 - c0 - c4
+   c1 + c3 = (r(1) - r(-1))/2
+   c1 + 4*c3 = (r(2) - c0 - 4*c2 - 16*c4)/2
+*/
+LargeInt toom3MagMult( const LargeInt &one, const LargeInt &other )
+{
+    unsigned int pieceSize = ( max( one.size, other.size ) + 2 ) / 3;
+    LargeInt pieces[ 3 ], oneValues[ 5 ], otherValues[ 5 ], products[ 5 ];
+    LargeInt oddSum, c1, c2, c3;
+    LargeInt result;
+    int index;
+
+    // evaluate one, and other unless squaring
+    for( index = 0; index < 3; index++ )
+    {
+        pieces[ index ] = one.digitSlice( index * pieceSize, pieceSize );
+    }
+    toom3Evaluate( pieces, oneValues );
+
+    if( &one == &other )
+    {
+        multiplyValues( products, oneValues, NULL, 5, one.size );
+    }
+    else
+    {
+        for( index = 0; index < 3; index++ )
+        {
+            pieces[ index ] = other.digitSlice( index * pieceSize, pieceSize );
+        }
+        toom3Evaluate( pieces, otherValues );
+
+        multiplyValues( products, oneValues, otherValues, 5, 
+                        max( one.size, other.size ) );
+    }
+
+    // c2 = (r(1) + r(-1))/2 - c0 - c4
+    c2 = products[ 1 ] + products[ 2 ];
+    c2 >>= 1;
+    c2 = c2 - products[ 0 ] - products[ 4 ];
+
+    // c1 + c3 = (r(1) - r(-1))/2
+    oddSum = products[ 1 ] - products[ 2 ];
+    oddSum >>= 1;
+
+    // c3 = ( (r(2) - c0 - 4*c2 - 16*c4)/2 - (c1 + c3) ) / 3
+    c3 = lazy( products[ 3 ] ) - products[ 0 ] - ( lazy( c2 ) << 2 ) - 
+         ( lazy( products[ 4 ] ) << 4 );
+    c3 >>= 1;
+    c3 -= oddSum;
+    c3.divideByDigit( 3 );
+
+    c1 = oddSum - c3;
+
+    // sum coefficients weighted by powers of B
+    result = products[ 0 ];
+    result.reallocate( one.size + other.size + 1 );
+    result.addMagnitudeAtIndex( c1, pieceSize );
+    result.addMagnitudeAtIndex( c2, 2 * pieceSize );
+    result.addMagnitudeAtIndex( c3, 3 * pieceSize );
+    result.addMagnitudeAtIndex( products[ 4 ], 4 * pieceSize );
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+/* toom4MagMult
+splits both operands into 4 pieces of pieceSize digits, as polynomials in
+B = <digit max + 1>^pieceSize:
+   one = one3*B^3 + one2*B^2 + one1*B + one0
+
+the product polynomial (degree 6) is evaluated at 0, 1, -1, 2, -2, 3, infinity
+with 7 recursive multiplications (squares if one and other are the same
+object), then interpolated:
+   c0 = r(0), c6 = r(inf)
+   c2 + c4 = (r(1) + r(-1))/2 - c0 - c6
+   4*c2 + 16*c4 = (r(2) + r(-2))/2 - c0 - 64*c6
+   c1 + c3 + c5 = (r(1) - r(-1))/2
+   c1 + 4*c3 + 16*c5 = (r(2) - r(-2))/4
+   c1 + 9*c3 + 81*c5 = (r(3) - c0 - 9*c2 - 81*c4 - 729*c6)/3
+*/
+LargeInt toom4MagMult( const LargeInt &one, const LargeInt &other )
+{
+    unsigned int pieceSize = ( max( one.size, other.size ) + 3 ) / 4;
+    LargeInt pieces[ 4 ], oneValues[ 7 ], otherValues[ 7 ], products[ 7 ];
+    LargeInt wkgOne;
+    LargeInt evenOne, evenTwo, oddOne, oddTwo, oddThree;
+    LargeInt c1, c2, c3, c4, c5;
+    LargeInt result;
+    int index;
+
+    // evaluate one, and other unless squaring
+    for( index = 0; index < 4; index++ )
+    {
+        pieces[ index ] = one.digitSlice( index * pieceSize, pieceSize );
+    }
+    toom4Evaluate( pieces, oneValues );
+
+    if( &one == &other )
+    {
+        multiplyValues( products, oneValues, NULL, 7, one.size );
+    }
+    else
+    {
+        for( index = 0; index < 4; index++ )
+        {
+            pieces[ index ] = other.digitSlice( index * pieceSize, pieceSize );
+        }
+        toom4Evaluate( pieces, otherValues );
+
+        multiplyValues( products, oneValues, otherValues, 7, 
+                        max( one.size, other.size ) );
+    }
+
+    // even coefficients: evenOne = c2 + c4, evenTwo = 4*c2 + 16*c4
+    evenOne = products[ 1 ] + products[ 2 ];
+    evenOne >>= 1;
+    evenOne -= products[ 0 ];
+    evenOne -= products[ 6 ];
+    wkgOne = products[ 6 ];
+    wkgOne <<= 6;
+    evenTwo = products[ 3 ] + products[ 4 ];
+    evenTwo >>= 1;
+    evenTwo -= products[ 0 ];
+    evenTwo -= wkgOne;
+
+    // c4 = (evenTwo - 4*evenOne)/12, c2 = evenOne - c4
+    c4 = lazy( evenTwo ) - ( lazy( evenOne ) << 2 );
+    c4.divideByDigit( 12 );
+    c2 = evenOne - c4;
+
+    // odd coefficients: oddOne = c1 + c3 + c5, oddTwo = c1 + 4*c3 + 16*c5,
+    // oddThree = c1 + 9*c3 + 81*c5
+    oddOne = products[ 1 ] - products[ 2 ];
+    oddOne >>= 1;
+    oddTwo = products[ 3 ] - products[ 4 ];
+    oddTwo >>= 2;
+    oddThree = lazy( products[ 5 ] ) - products[ 0 ] - lazy( c2 ) * 9 - 
+               lazy( c4 ) * 81 - lazy( products[ 6 ] ) * 729;
+    oddThree.divideByDigit( 3 );
+
+    // c3 + 5*c5 = (oddTwo - oddOne)/3, c3 + 10*c5 = (oddThree - oddOne)/8
+    c3 = oddTwo - oddOne;
+    c3.divideByDigit( 3 );
+    c5 = oddThree - oddOne;
+    c5 >>= 3;
+    c5 -= c3;
+    c5.divideByDigit( 5 );
+    wkgOne = c5;
+    wkgOne *= 5;
+    c3 -= wkgOne;
+    c1 = oddOne - c3 - c5;
+
+    // sum coefficients weighted by powers of B
+    result = products[ 0 ];
+    result.reallocate( one.size + other.size + 1 );
+    result.addMagnitudeAtIndex( c1, pieceSize );
+    result.addMagnitudeAtIndex( c2, 2 * pieceSize );
+    result.addMagnitudeAtIndex( c3, 3 * pieceSize );
+    result.addMagnitudeAtIndex( c4, 4 * pieceSize );
+    result.addMagnitudeAtIndex( c5, 5 * pieceSize );
+    result.addMagnitudeAtIndex( products[ 6 ], 6 * pieceSize );
+
+    result.removeLeadingZeros();
+    return result;
+}
+
+
+
+
+//////////////////////////// limb arrays //////////////////////////////////////
+// the public layer over the digit array helpers above
+LI_Limbs::limb LI_Limbs::add_n( limb *result, const limb *one, const limb *other, 
+                                size_t size )
+{
+    return addDigitsWithCarry( result, one, other, (unsigned int)size );
+}
+
+LI_Limbs::limb LI_Limbs::add( limb *result, const limb *one, size_t oneSize, 
+                              const limb *other, size_t otherSize )
+{
+    return addDigitArrays( result, one, (unsigned int)oneSize, 
+                           other, (unsigned int)otherSize );
+}
+
+LI_Limbs::limb LI_Limbs::sub_n( limb *result, const limb *one, const limb *other, 
+                                size_t size )
+{
+    return subtractDigitsWithBorrow( result, one, other, (unsigned int)size );
+}
+
+LI_Limbs::limb LI_Limbs::sub( limb *result, const limb *one, size_t oneSize, 
+                              const limb *other, size_t otherSize )
+{
+    return subtractDigitArrays( result, one, (unsigned int)oneSize, 
+                                other, (unsigned int)otherSize );
+}
+
+LI_Limbs::limb LI_Limbs::mul_1( limb *result, const limb *value, size_t size, 
+                                limb multiplier )
+{
+    return multiplyDigitArray( result, value, (unsigned int)size, multiplier );
+}
+
+LI_Limbs::limb LI_Limbs::addmul_1( limb *result, const limb *value, size_t size, 
+                                   limb multiplier )
+{
+    return addMultipleOfDigitArray( result, value, (unsigned int)size, multiplier );
+}
+
+LI_Limbs::limb LI_Limbs::submul_1( limb *result, const limb *value, size_t size, 
+                                   limb multiplier )
+{
+    return subtractMultipleOfDigitArray( result, value, (unsigned int)size, 
+                                         multiplier );
+}
+
+// the same algorithm choice as multiplyLIMagnitude
+void LI_Limbs::mul( limb *result, const limb *one, size_t oneSize, 
+                    const limb *other, size_t otherSize )
+{
+    if( otherSize == 1 )
+    {
+        result[ oneSize ] = multiplyDigitArray( result, one, (unsigned int)oneSize, 
+                                                other[ 0 ] );
+        return;
+    }
+    if( otherSize < LI_Properties::multiplication::KARATSUBA_THRESHOLD )
+    {
+        gradeschoolLimbs( result, one, (unsigned int)oneSize, 
+                          other, (unsigned int)otherSize );
+        return;
+    }
+    if( usesNumberTheoreticTransform( (unsigned int)oneSize, (unsigned int)otherSize ) )
+    {
+        nttLimbs( result, one, (unsigned int)oneSize, other, (unsigned int)otherSize );
+        return;
+    }
+    if( otherSize >= LI_Properties::multiplication::TOOM3_THRESHOLD )
+    {
+        // Toom-3/4 work on LargeInts: copy the operands in and the product out
+        LargeInt wkgOne, wkgOther, product;
+        wkgOne.resize( (unsigned int)oneSize );
+        copyArray( one, wkgOne.digits, (unsigned int)oneSize );
+        wkgOne.removeLeadingZeros();
+        wkgOther.resize( (unsigned int)otherSize );
+        copyArray( other, wkgOther.digits, (unsigned int)otherSize );
+        wkgOther.removeLeadingZeros();
+
+        product = multiplyLIMagnitude( wkgOne, wkgOther );
+        copyArray( product.digits, result, product.size );
+        for( size_t index = product.size; index < oneSize + otherSize; index++ )
+        {
+            result[ index ] = 0;
+        }
+        return;
+    }
+
+    // (blocks of an unbalanced product are no larger than other)
+    LargeIntScratchScope scratch;
+    karatsubaLimbs( result, one, (unsigned int)oneSize, 
+                    other, (unsigned int)otherSize, 
+                    scratch.allocate<LI_Properties::digit::type>( karatsubaScratchSize( 
+                        (unsigned int)min( oneSize, 2 * otherSize ) ) ) );
+}
+
+LI_Limbs::limb LI_Limbs::lshift( limb *result, const limb *value, size_t size, 
+                                 unsigned int shiftBits )
+{
+    return shiftLeftDigitArray( result, value, (unsigned int)size, shiftBits );
+}
+
+LI_Limbs::limb LI_Limbs::rshift( limb *result, const limb *value, size_t size, 
+                                 unsigned int shiftBits )
+{
+    return shiftRightDigitArray( result, value, (unsigned int)size, shiftBits );
+}
+
+LI_Limbs::limb LI_Limbs::divrem_1( limb *quotient, const limb *value, size_t size, 
+                                   limb divisor )
+{
+    return divideDigitArray( quotient, value, (unsigned int)size, divisor );
+}
+
+int LI_Limbs::cmp( const limb *one, const limb *other, size_t size )
+{
+    size_t index;
+
+    for( index = size; index > 0; index-- )
+    {
+        if( one[ index - 1 ] != other[ index - 1 ] )
+        {
+            return one[ index - 1 ] < other[ index - 1 ] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+
+
+
+
+
+/////////// division ////////////
+LI_Properties::digit::type LargeInt::divideByDigit( 
+                                     LI_Properties::digit::type divisor )
+{
+    LI_Properties::digit::type remainder;
+
+    remainder = divideDigitArray( digits, digits, size, divisor );
+    removeLeadingZeros();
+
+    return remainder;
+}
+
+/* schoolbookDivideLimbs
+Knuth's algorithm D: stores numerator / denominator into quotient
+(numeratorSize - denominatorSize + 1 digits) and numerator % denominator into
+remainder (denominatorSize digits)
+
+both operands are shifted so the top bit of the denominator is set, then each
+quotient digit is estimated from the top two numerator digits divided by the
+top denominator digit (corrected with the second denominator digit), which is
+at most one too large after correction; the estimate times the denominator is
+subtracted in place, adding the denominator back if the estimate was too large
+
+Requirements:
+ - denominatorSize is at least 2, with a non-zero top digit
+ - numeratorSize is at least denominatorSize
+*/
+static void schoolbookDivideLimbs( LI_Properties::digit::type *quotient,
+                                   LI_Properties::digit::type *remainder,
+                                   const LI_Properties::digit::type *numerator,
+                                   unsigned int numeratorSize,
+                                   const LI_Properties::digit::type *denominator,
+                                   unsigned int denominatorSize )
+{
+    const LI_Properties::digit::doubleSize::type digitBase = 
+              (LI_Properties::digit::doubleSize::type)LI_Properties::digit::MAX + 1;
+    unsigned int shiftBits = leadingZeroBits( denominator[ denominatorSize - 1 ] );
+    LI_Properties::digit::type *wkgNumerator, *wkgDenominator;
+    LargeIntScratchScope scratch;
+    LI_Properties::digit::type topDenominator, nextDenominator, owe;
+    LI_Properties::digit::doubleSize::type topNumerator, estimate, estimateRemainder;
+    unsigned int quotientInd;
+
+    // normalize (numerator gets an extra top digit for the shifted out bits)
+    wkgNumerator = scratch.allocate<LI_Properties::digit::type>( numeratorSize + 1 );
+    wkgDenominator = scratch.allocate<LI_Properties::digit::type>( denominatorSize );
+    shiftLeftDigitArray( wkgDenominator, denominator, denominatorSize, shiftBits );
+    wkgNumerator[ numeratorSize ] = shiftLeftDigitArray( wkgNumerator, numerator, 
+                                                         numeratorSize, shiftBits );
+    topDenominator = wkgDenominator[ denominatorSize - 1 ];
+    nextDenominator = wkgDenominator[ denominatorSize - 2 ];
+
+    // iterate quotient digits most significant->least
+    for( quotientInd = numeratorSize - denominatorSize + 1; quotientInd > 0; )
+    {
+        quotientInd--;
+        LI_Properties::digit::type *window = wkgNumerator + quotientInd;
+
+        // estimate from the top two digits of the current window
+        topNumerator = ( (LI_Properties::digit::doubleSize::type)
+                         window[ denominatorSize ] << LI_Properties::digit::SIZE ) |
+                       window[ denominatorSize - 1 ];
+        estimate = topNumerator / topDenominator;
+        estimateRemainder = topNumerator % topDenominator;
+
+        // correct using the second denominator digit (at most twice)
+        while( estimate >= digitBase ||
+               estimate * nextDenominator > 
+               ( ( estimateRemainder << LI_Properties::digit::SIZE ) | 
+                 window[ denominatorSize - 2 ] ) )
+        {
+            estimate--;
+            estimateRemainder += topDenominator;
+            if( estimateRemainder >= digitBase )
+            {
+                break;
+            }
+        }
+
+        // window -= estimate * denominator
+        owe = subtractMultipleOfDigitArray( window, wkgDenominator, denominatorSize, 
+                                            (LI_Properties::digit::type)estimate );
+        if( window[ denominatorSize ] < owe )
+        {
+            // estimate was one too large: add the denominator back
+            estimate--;
+            window[ denominatorSize ] += 
+                addDigitArrays( window, window, denominatorSize, 
+                                wkgDenominator, denominatorSize );
+        }
+        window[ denominatorSize ] -= owe;
+
+        quotient[ quotientInd ] = (LI_Properties::digit::type)estimate;
+    }
+
+    // remainder is the remaining window (less than the denominator), shifted back
+    shiftRightDigitArray( remainder, wkgNumerator, denominatorSize, shiftBits );
+}
+
+LargeInt operator/( const LargeInt &numerator, const LargeInt &denominator )
+{
+    LargeInt divisionResult, remainder;
+    divideLIMagnitude( numerator, denominator, divisionResult, remainder );
+    divisionResult.sign = numerator.sign != denominator.sign && 
+                          divisionResult.size != 0;
+
+    return divisionResult;
+}
+
+// (division normalizes working copies of both operands anyway, so the views
+// are copied into them)
+LargeInt operator/( const LargeIntView &numerator, const LargeIntView &denominator )
+{
+    return LargeInt( numerator ) / LargeInt( denominator );
+}
+
+
+// magnitude division: divisionResult = |numerator| / |denominator|,
+// remainder = |numerator| % |denominator|
+// (numerator or denominator may be the same object as either result)
+void divideLIMagnitude( const LargeInt &numerator, const LargeInt &denominator, 
+                            LargeInt &divisionResult, LargeInt &remainder )
+{
+    LargeInt quotient, wkgRemainder;
+
+    if( denominator.size == 0 )
+    {
+        throw std::overflow_error( "division by zero in divideLIMagnitude\n" );
+    }
+
+    // numerator is smaller: quotient is 0, remainder is numerator
+    if( spaceshipMagComp( numerator, denominator ) < 0 )
+    {
+        wkgRemainder = numerator;
+        wkgRemainder.sign = false;
+        divisionResult = LargeInt( 0 );
+        remainder = std::move( wkgRemainder );
+        return;
+    }
+
+    // large quotients and denominators: subquadratic division
+    if( min( numerator.size - denominator.size + 1, denominator.size ) >= 
+        LI_Properties::division::NEWTON_THRESHOLD )
+    {
+        newtonDivideMagnitude( numerator, denominator, divisionResult, remainder );
+        return;
+    }
+    if( min( numerator.size - denominator.size + 1, denominator.size ) >= 
+        LI_Properties::division::BURNIKEL_ZIEGLER_THRESHOLD )
+    {
+        recursiveDivideMagnitude( numerator, denominator, divisionResult, remainder );
+        return;
+    }
+
+    quotient.resize( numerator.size - denominator.size + 1 );
+
+    if( denominator.size == 1 )
+    {
+        // single digit: divide digit by digit with a running remainder
+        wkgRemainder = LargeInt( divideDigitArray( quotient.digits, numerator.digits, 
+                                                   numerator.size, 
+                                                   denominator.digits[ 0 ] ) );
+    }
+    else
+    {
+        wkgRemainder.resize( denominator.size );
+        schoolbookDivideLimbs( quotient.digits, wkgRemainder.digits, 
+                               numerator.digits, numerator.size,
+                               denominator.digits, denominator.size );
+        wkgRemainder.removeLeadingZeros();
+    }
+    quotient.removeLeadingZeros();
+
+    // store results last, in case they alias the operands
+    divisionResult = std::move( quotient );
+    remainder = std::move( wkgRemainder );
+}
+
+
+/* divideThreeByTwoBlocks
+Burnikel-Ziegler: divides numerator = [A1 A2 A3] by denominator = [B1 B2]
+(each block blockSize digits), where numerator < denominator * B^blockSize
+and the denominator's top bit is set
+
+the quotient estimate from [A1 A2] / B1 is at most 2 too large:
+   estimate = [A1 A2] / B1 (or B^blockSize - 1 if A1 >= B1)
+   remainder = ( [A1 A2] - estimate * B1 ) * B^blockSize + A3 - estimate * B2
+   while remainder < 0: remainder += denominator, estimate -= 1
+*/
+void divideThreeByTwoBlocks( const LargeInt &numerator, const LargeInt &denominator,
+                             unsigned int blockSize,
+                             LargeInt &divisionResult, LargeInt &remainder )
+{
+    LargeInt denominatorHigh = denominator.digitSlice( blockSize, blockSize );
+    LargeInt denominatorLow = denominator.digitSlice( 0, blockSize );
+    LargeInt numeratorTop = numerator.digitSlice( 2 * blockSize, blockSize );
+    LargeInt numeratorHigh = numerator.digitSlice( blockSize, 2 * blockSize );
+    LargeInt estimate, wkgRemainder, wkgValue;
+
+    if( spaceshipMagComp( numeratorTop, denominatorHigh ) < 0 )
+    {
+        divideTwoByOneBlocks( numeratorHigh, denominatorHigh, blockSize, 
+                              estimate, wkgRemainder );
+    }
+    else
+    {
+        // estimate = B^blockSize - 1, [A1 A2] - estimate * B1 = [A1 A2] - [B1 0] + B1
+        estimate = LargeInt( 1 );
+        estimate.digitShiftGreater( blockSize );
+        estimate -= LargeInt( 1 );
+        wkgValue = denominatorHigh;
+        wkgValue.digitShiftGreater( blockSize );
+        wkgRemainder = numeratorHigh - wkgValue + denominatorHigh;
+    }
+
+    // remainder = wkgRemainder * B^blockSize + A3 - estimate * B2
+    wkgRemainder.digitShiftGreater( blockSize );
+    wkgRemainder += LargeIntView( numerator ).slice( 0, blockSize );
+    wkgRemainder.submul( estimate, denominatorLow );
+
+    // correct the estimate (at most twice)
+    while( wkgRemainder.sign && wkgRemainder.size != 0 )
+    {
+        wkgRemainder += denominator;
+        estimate -= LargeInt( 1 );
+    }
+
+    divisionResult = std::move( estimate );
+    remainder = std::move( wkgRemainder );
+}
+
+/* divideTwoByOneBlocks
+Burnikel-Ziegler: divides numerator = [A1 A2 A3 A4] (each block half of
+blockSize digits) by denominator (blockSize digits, top bit set), where
+numerator < denominator * B^blockSize
+
+   [A1 A2 A3] / denominator -> quotient high, remainder R
+   [R A4] / denominator     -> quotient low, remainder
+both as 3 by 2 block divisions, which recurse back on half the size
+*/
+void divideTwoByOneBlocks( const LargeInt &numerator, const LargeInt &denominator,
+                           unsigned int blockSize,
+                           LargeInt &divisionResult, LargeInt &remainder )
+{
+    unsigned int halfSize = blockSize / 2;
+    LargeInt quotientHigh, quotientLow, wkgRemainder;
+
+    // terminate recursion when blocks no longer halve evenly
+    if( blockSize % 2 != 0 || 
+        blockSize < LI_Properties::division::BURNIKEL_ZIEGLER_THRESHOLD )
+    {
+        divideLIMagnitude( numerator, denominator, divisionResult, remainder );
+        return;
+    }
+
+    divideThreeByTwoBlocks( numerator.digitSlice( halfSize, 3 * halfSize ), 
+                            denominator, halfSize, quotientHigh, wkgRemainder );
+
+    wkgRemainder.digitShiftGreater( halfSize );
+    wkgRemainder += LargeIntView( numerator ).slice( 0, halfSize );
+    divideThreeByTwoBlocks( wkgRemainder, denominator, halfSize, 
+                            quotientLow, remainder );
+
+    // quotient = quotientHigh * B^halfSize + quotientLow
+    divisionResult = quotientHigh;
+    divisionResult.digitShiftGreater( halfSize );
+    divisionResult.addMagnitudeAtIndex( quotientLow, 0 );
+}
+
+/* recursiveDivideMagnitude
+Burnikel-Ziegler recursive division, for numerator >= denominator:
+ - the denominator is shifted to blockSize = j * 2^k digits (j below the
+   threshold) with its top bit set, so blocks halve evenly down to the
+   schoolbook base case; the numerator is shifted equally
+ - the numerator is divided in blocks of blockSize digits, most
+   significant first, each step a 2 by 1 block division of
+   [remainder, next block]
+*/
+void recursiveDivideMagnitude( const LargeInt &numerator, 
+                               const LargeInt &denominator, 
+                               LargeInt &divisionResult, LargeInt &remainder )
+{
+    unsigned int blockSize, blockScale = 1;
+    unsigned int shiftBits, numeratorBits, blockCount, blockInd;
+    LargeInt wkgNumerator = numerator;
+    LargeInt wkgDenominator = denominator;
+    LargeInt quotient, blockQuotient, wkgRemainder;
+
+    // smallest power of two scale leaving fewer than threshold digits per block
+    while( ( denominator.size + blockScale - 1 ) / blockScale >= 
+           LI_Properties::division::BURNIKEL_ZIEGLER_THRESHOLD )
+    {
+        blockScale <<= 1;
+    }
+    blockSize = ( ( denominator.size + blockScale - 1 ) / blockScale ) * blockScale;
+
+    // shift so the denominator fills blockSize digits exactly, top bit set
+    shiftBits = ( blockSize - denominator.size ) * LI_Properties::digit::SIZE + 
+                leadingZeroBits( denominator.digits[ denominator.size - 1 ] );
+    wkgNumerator.sign = false;
+    wkgDenominator.sign = false;
+    wkgNumerator <<= shiftBits;
+    wkgDenominator <<= shiftBits;
+
+    // blocks in the numerator, leaving the top block's top bit clear
+    // (so the first two blocks are less than denominator * B^blockSize)
+    numeratorBits = wkgNumerator.size * LI_Properties::digit::SIZE - 
+                    leadingZeroBits( wkgNumerator.digits[ wkgNumerator.size - 1 ] );
+    blockCount = max( 2u, ( numeratorBits + 1 + 
+                            blockSize * LI_Properties::digit::SIZE - 1 ) /
+                          ( blockSize * LI_Properties::digit::SIZE ) );
+
+    // divide most significant blocks first
+    wkgRemainder = wkgNumerator.digitSlice( ( blockCount - 2 ) * blockSize, 
+                                            2 * blockSize );
+    for( blockInd = blockCount - 1; blockInd > 0; blockInd-- )
+    {
+        divideTwoByOneBlocks( wkgRemainder, wkgDenominator, blockSize, 
+                              blockQuotient, wkgRemainder );
+        quotient.addMagnitudeAtIndex( blockQuotient, ( blockInd - 1 ) * blockSize );
+
+        // bring down the next block
+        if( blockInd > 1 )
+        {
+            wkgRemainder.digitShiftGreater( blockSize );
+            wkgRemainder.addMagnitudeAtIndex( 
+                wkgNumerator.digitSlice( ( blockInd - 2 ) * blockSize, blockSize ), 
+                0 );
+        }
+    }
+
+    // undo the normalizing shift on the remainder
+    wkgRemainder >>= shiftBits;
+    quotient.removeLeadingZeros();
+
+    divisionResult = std::move( quotient );
+    remainder = std::move( wkgRemainder );
+}
+
+/* newtonReciprocal
+returns floor( B^(2n) / denominator ) for a denominator of n digits with its
+top bit set, B = <digit max + 1>
+
+the reciprocal of the top half of the denominator (recursively) is accurate
+to about half the digits, one Newton step doubles that:
+   X = X + X * ( B^(2n) - denominator * X ) / B^(2n)
+then the result is corrected to the exact floor
+
+denominators of fewer than cutoff digits (or of 1 digit) are divided
+directly; a smaller cutoff than NEWTON_THRESHOLD runs the Newton steps on
+small values
+*/
+LargeInt newtonReciprocal( const LargeInt &denominator, unsigned int cutoff )
+{
+    unsigned int size = denominator.size;
+    unsigned int halfSize = ( size + 1 ) / 2;
+    LargeInt reciprocal, halfReciprocal, error, correction, wkgRemainder;
+    LargeInt unit = LargeInt( 1 );
+
+    unit.digitShiftGreater( 2 * size );
+
+    // terminate recursion with a direct division
+    if( size < cutoff || size == 1 )
+    {
+        divideLIMagnitude( unit, denominator, reciprocal, wkgRemainder );
+        return reciprocal;
+    }
+
+    // reciprocal of the top half, X = <half reciprocal> * B^(n-h)
+    halfReciprocal = newtonReciprocal( denominator.digitSlice( size - halfSize, halfSize ), 
+                                       cutoff );
+
+    // Newton step, error = B^(2n) - denominator * X (may be negative)
+    // the trailing zero digits of X are left out of both products
+    error = denominator * halfReciprocal;
+    error.digitShiftGreater( size - halfSize );
+    error = unit - error;
+    correction = halfReciprocal * error;
+    correction.digitShiftLesser( min( size + halfSize, correction.size ) );
+    correction.sign = correction.sign && correction.size != 0;
+    reciprocal = halfReciprocal;
+    reciprocal.digitShiftGreater( size - halfSize );
+    reciprocal += correction;
+
+    // remainder of the new estimate, without another full multiplication
+    wkgRemainder = error;
+    wkgRemainder.submul( denominator, correction );
+
+    // correct to the exact floor
+    while( wkgRemainder.sign && wkgRemainder.size != 0 )
+    {
+        wkgRemainder += denominator;
+        reciprocal -= LargeInt( 1 );
+    }
+    while( spaceshipMagComp( wkgRemainder, denominator ) >= 0 )
+    {
+        wkgRemainder -= denominator;
+        reciprocal += LargeInt( 1 );
+    }
+
+    return reciprocal;
+}
+
+/* newtonDivideMagnitude
+division by multiplying with the reciprocal, for numerator >= denominator:
+ - both operands are shifted so the denominator's top bit is set, and
+   X = floor( B^(2n) / denominator ) is computed once
+ - the numerator is divided in blocks of n digits, most significant first:
+   for current = [remainder, next block] (less than denominator * B^n),
+   quotient = ( current / B^(n-1) ) * X / B^(n+1) is at most 3 too small,
+   and is corrected with the remainder
+reciprocalCutoff is passed to newtonReciprocal
+*/
+void newtonDivideMagnitude( const LargeInt &numerator, 
+                            const LargeInt &denominator, 
+                            LargeInt &divisionResult, LargeInt &remainder,
+                            unsigned int reciprocalCutoff )
+{
+    unsigned int shiftBits = leadingZeroBits( denominator.digits[ denominator.size - 1 ] );
+    unsigned int blockSize = denominator.size;
+    unsigned int blockCount, blockInd;
+    LargeInt wkgNumerator = numerator;
+    LargeInt wkgDenominator = denominator;
+    LargeInt reciprocal, quotient, blockQuotient, wkgRemainder;
+
+    // normalize so the denominator's top bit is set
+    wkgNumerator.sign = false;
+    wkgDenominator.sign = false;
+    wkgNumerator <<= shiftBits;
+    wkgDenominator <<= shiftBits;
+
+    reciprocal = newtonReciprocal( wkgDenominator, reciprocalCutoff );
+
+    // divide most significant blocks first
+    blockCount = ( wkgNumerator.size + blockSize - 1 ) / blockSize;
+    for( blockInd = blockCount; blockInd > 0; blockInd-- )
+    {
+        // bring down the next block
+        wkgRemainder.digitShiftGreater( blockSize );
+        wkgRemainder += LargeIntView( wkgNumerator ).slice( ( blockInd - 1 ) * blockSize, 
+                                                            blockSize );
+
+        // estimate from the top digits only (at most 3 too small),
+        // then correct upward
+        blockQuotient = wkgRemainder;
+        blockQuotient.digitShiftLesser( min( blockSize - 1, blockQuotient.size ) );
+        blockQuotient = blockQuotient * reciprocal;
+        blockQuotient.digitShiftLesser( min( blockSize + 1, blockQuotient.size ) );
+        wkgRemainder.submul( blockQuotient, wkgDenominator );
+        while( spaceshipMagComp( wkgRemainder, wkgDenominator ) >= 0 )
+        {
+            wkgRemainder -= wkgDenominator;
+            blockQuotient += LargeInt( 1 );
+        }
+
+        quotient.addMagnitudeAtIndex( blockQuotient, ( blockInd - 1 ) * blockSize );
+    }
+
+    // undo the normalizing shift on the remainder
+    wkgRemainder >>= shiftBits;
+    quotient.removeLeadingZeros();
+
+    divisionResult = std::move( quotient );
+    remainder = std::move( wkgRemainder );
+}
+
+
+/////////////////////////////////// LI display ////////////////////////////////
+std::string LargeInt::toStringBruteForce( unsigned int base, 
+                                          unsigned int forceSize ) const
+{
+    if( size == 0 )
+    {
+        return (std::string)"0";
+    }
+
+    LargeInt copy = *this;
+    std::string wkgStr;
+
+    // divide the copy in place, collecting digits least significant first
+    while( copy.size != 0 )
+    {
+        wkgStr.push_back( intToChar( (int)copy.divideByDigit( base ) ) );
+    }
+    std::reverse(wkgStr.begin(), wkgStr.end());
+    if( forceSize > wkgStr.size() )
+    {
+        wkgStr = std::string( forceSize - wkgStr.size(), '0' ) + wkgStr;
+    }
+    return wkgStr;
+}
+
+std::string LargeInt::toString( unsigned int base ) const
+{
+    return toString( sharedPowerCache( base ) );
+}
+
+std::string LargeInt::toString( LargeIntPowerCache &powerCache ) const
+{
+    std::string resultStr;
+    if( size == 0 )
     {
-        greater = &one;
-        smaller = &other;
+        return (std::string)"0";
     }
-    else
+    if( sign )
     {
-        greater = &other;
-        smaller = &one;
+        resultStr.push_back( '-' );
     }
+    resultStr += stringMagnitude( powerCache, 0 );
 
-    // subtract magnitude of smaller from greater
-    result = subtractMagnitude( *greater, *smaller );
-
-    // set result sign to sign of the greater value
-    result.sign = greater->sign;
+    return resultStr;
+}
 
-    return result;
+std::string LargeInt::stringMagnitude( unsigned int base, unsigned int forceSize ) const
+{
+    return stringMagnitude( sharedPowerCache( base ), forceSize );
 }
 
+// ceil( 2^32 * log_base(2) ) for bases 2 to 36
+static const uint64_t characterFactors[ 35 ] =
+{
+    0x100000000ULL, 0xA1849CC2ULL, 0x80000000ULL, 0x6E40D1A5ULL, 0x6308C91CULL,
+    0x5B3064ECULL, 0x55555556ULL, 0x50C24E61ULL, 0x4D104D43ULL, 0x4A002708ULL,
+    0x4768CE0EULL, 0x452E53E4ULL, 0x433CFFFCULL, 0x41867712ULL, 0x40000000ULL,
+    0x3EA16AFEULL, 0x3D64598EULL, 0x3C43C231ULL, 0x3B3B9A43ULL, 0x3A4898F1ULL,
+    0x39680B14ULL, 0x3897B2B8ULL, 0x37D5AED2ULL, 0x372068D3ULL, 0x3676867FULL,
+    0x35D6DEECULL, 0x354071D7ULL, 0x34B260C6ULL, 0x342BE987ULL, 0x33AC61BAULL,
+    0x33333334ULL, 0x32BFD902ULL, 0x3251DCF7ULL, 0x31E8D5A0ULL, 0x3184648EULL
+};
+
+// a value below 2^bitCount has at most floor( bitCount * log_base(2) ) + 1
+// characters, and the factor rounded up keeps the product at least that
+static unsigned int characterBound( unsigned int bitCount, unsigned int base )
+{
+    return (unsigned int)( ( (uint64_t)bitCount * characterFactors[ base - 2 ] ) >> 32 ) + 1;
+}
 
-// adds magnitude of two LargeInts
-// sign is ignored, and the result sign is positive
-LargeInt addMagnitude( const LargeInt &one, const LargeInt &other )
+// the magnitude's characters are written into one buffer of at least
+// their count (from the bit count), then the extra leading zeros are removed
+std::string LargeInt::stringMagnitude( LargeIntPowerCache &powerCache, 
+                                       unsigned int forceSize ) const
 {
-    LargeInt result = LargeInt();
-    const LargeInt *larger, *smaller;
-    unsigned int remainder;
-    unsigned int digitInd;
+    unsigned int level, charCount, firstChar;
 
-    // extract larger/smaller
-    if( one.size >= other.size )
+    // power of two bases: read the bits of each character directly
+    if( ( powerCache.getBase() & ( powerCache.getBase() - 1 ) ) == 0 )
     {
-        larger = &one;
-        smaller = &other;
+        for( level = 0; ( 1u << level ) < powerCache.getBase(); level++ );
+        return stringPowerOfTwoBase( level, forceSize );
     }
-    else
+
+    // (computed up front, parallel halves only read the cache)
+    if( size > LI_Properties::conversion::STRING_CHUNK_THRESHOLD )
     {
-        larger = &other;
-        smaller = &one;
+        powerCache.precompute( size );
     }
 
-    // resize for one more than the larger
-    result.reallocate( larger->size + 1 );
-    result.resize( larger->size );
+    charCount = max( characterBound( significantBits( digits, size ), 
+                                     powerCache.getBase() ), 
+                     forceSize );
+    std::string wkgStr( charCount, '0' );
+    writeMagnitude( powerCache, &wkgStr[ 0 ], charCount );
+
+    for( firstChar = 0; firstChar + forceSize < charCount && wkgStr[ firstChar ] == '0'; 
+         firstChar++ );
+    wkgStr.erase( 0, firstChar );
+    return wkgStr;
+}
+
+/*
+the magnitude is split by the largest cached power of at most about half
+its size: the remainder fills exactly chunkDigits * 2^level characters at the
+end and the quotient the rest, so both halves write straight into place (in
+parallel when large)
+*/
+void LargeInt::writeMagnitude( LargeIntPowerCache &powerCache, char *first, 
+                               unsigned int count ) const
+{
+    unsigned int level, lowerSize, chunkInd;
+    LI_Properties::digit::type chunkValue;
+    LargeInt divisionResult, remainder;
+    char *wkgChar = first + count;
 
-    // start with no remainder
-    remainder = 0;
-    // add smaller/larger digits and remainder into result
-    for( digitInd = 0; digitInd < smaller->size; digitInd++ )
+    // if reasonable size, terminate
+    if( size <= LI_Properties::conversion::STRING_CHUNK_THRESHOLD )
     {
-        result.digits[ digitInd ] = smaller->digits[ digitInd ] + 
-                                    larger->digits[ digitInd ] + 
-                                    remainder;
-        // calculate remainder
-        if( remainder )
+        // divide a copy in place by chunkBase, writing the characters of
+        // each chunk from the end
+        LargeInt copy = *this;
+        while( copy.size != 0 )
         {
-            // remainder occurred if result is less than one
-            // (because a remainder should be added, overflow also occurs if equal)
-            remainder = result.digits[ digitInd ] <= one.digits[ digitInd ]; 
+            chunkValue = copy.divideByDigit( powerCache.getChunkBase() );
+            for( chunkInd = 0; chunkInd < powerCache.getChunkDigits() && wkgChar != first; 
+                 chunkInd++ )
+            {
+                wkgChar--;
+                *wkgChar = intToChar( (int)( chunkValue % powerCache.getBase() ) );
+                chunkValue /= powerCache.getBase();
+            }
         }
-        else
+
+        // pad to count
+        while( wkgChar != first )
         {
-            // remainder occurred if result is less than one
-            remainder = result.digits[ digitInd ] < one.digits[ digitInd ];
+            wkgChar--;
+            *wkgChar = '0';
         }
+        return;
+    }
+
+    // largest power with twice its size within this size
+    level = 0;
+    while( level + 1 < LI_Properties::conversion::MAX_POWER_LEVELS &&
+           2 * powerCache.power( level + 1 ).size <= size + 1 )
+    {
+        level++;
     }
+    lowerSize = powerCache.getChunkDigits() << level;
+
+    // divide self by chunkBase^(2^level), store divisionResult and remainder
+    divideLIMagnitude( *this, powerCache.power( level ), divisionResult, remainder );
 
-    // continue to end of larger digit
-    while( digitInd < larger->size )
+    // greater->smaller, the smaller as a task when large
+    if( size >= LI_Properties::conversion::PARALLEL_THRESHOLD && runsInParallel() )
     {
-        result.digits[ digitInd ] = larger->digits[ digitInd ] + remainder;
-        remainder &= larger->digits[ digitInd ] == LI_Properties::digit::MAX;
+        LargeIntTaskGroup group;
 
-        digitInd++;
+        group.run( [&remainder, &powerCache, first, count, lowerSize]
+                   { remainder.writeMagnitude( powerCache, first + count - lowerSize, 
+                                               lowerSize ); } );
+        divisionResult.writeMagnitude( powerCache, first, count - lowerSize );
+        group.wait();
+        return;
     }
+    divisionResult.writeMagnitude( powerCache, first, count - lowerSize );
+    remainder.writeMagnitude( powerCache, first + count - lowerSize, lowerSize );
+}
 
-    if( remainder )
+
+// the base 2^bitsPerChar character starting at bit bitInd of digits
+static char powerOfTwoBaseCharacter( const LI_Properties::digit::type *digits,
+                                     unsigned int size, unsigned int bitInd,
+                                     unsigned int bitsPerChar )
+{
+    unsigned int digitInd = bitInd / LI_Properties::digit::SIZE;
+    unsigned int bitOffset = bitInd % LI_Properties::digit::SIZE;
+    LI_Properties::digit::doubleSize::type window;
+
+    // (reading across digit boundaries)
+    window = digits[ digitInd ] >> bitOffset;
+    if( bitOffset + bitsPerChar > (unsigned int)LI_Properties::digit::SIZE && 
+        digitInd + 1 < size )
     {
-        // store remainder at last digit if necessary
-        result.digits[ result.size ] = 1; // safe due to excessive previous allocation
-        result.size += 1;
+        window |= (LI_Properties::digit::doubleSize::type)digits[ digitInd + 1 ] << 
+                  ( LI_Properties::digit::SIZE - bitOffset );
     }
+    return intToChar( (int)( window & ( ( 1u << bitsPerChar ) - 1 ) ) );
+}
 
-    return result;
+// characters of digits[ 0 ] to digits[ size ] (exclusive) in base
+// 2^bitsPerChar, most significant first, padded with zeros to forceSize
+static std::string powerOfTwoBaseString( const LI_Properties::digit::type *digits,
+                                         unsigned int size,
+                                         unsigned int bitsPerChar, 
+                                         unsigned int forceSize )
+{
+    unsigned int bitCount, charCount, charInd, bitInd;
+
+    bitCount = significantBits( digits, size );
+    charCount = max( ( bitCount + bitsPerChar - 1 ) / bitsPerChar, forceSize );
+    std::string wkgStr( charCount, '0' );
+
+    // least significant character last
+    for( charInd = charCount, bitInd = 0; bitInd < bitCount; bitInd += bitsPerChar )
+    {
+        charInd--;
+        wkgStr[ charInd ] = powerOfTwoBaseCharacter( digits, size, bitInd, bitsPerChar );
+    }
+
+    return wkgStr;
 }
 
-void LargeInt::addDigitAtIndex( LI_Properties::digit::type toAdd, 
-                                unsigned int addIndex )
+std::string LargeInt::stringPowerOfTwoBase( unsigned int bitsPerChar, 
+                                            unsigned int forceSize ) const
 {
-    bool remainder;
-    if( size <= addIndex )
+    return powerOfTwoBaseString( digits, size, bitsPerChar, forceSize );
+}
+
+// power of two bases are read straight from the view's digits; other bases
+// divide, which needs working LargeInts (a copy is small next to that)
+std::string toString( const LargeIntView &value, unsigned int base )
+{
+    unsigned int bitsPerChar;
+    std::string resultStr;
+
+    if( base < 2 || ( base & ( base - 1 ) ) != 0 )
     {
-        // +1 to include index, +1 for possible overflow
-        resize( addIndex + 1 + 1 );
+        return LargeInt( value ).toString( base );
     }
-    else
+    if( value.limbCount() == 0 )
     {
-        // +1 for possible overflow
-        resize( size + 1 );
+        return (std::string)"0";
     }
-
-    digits[ addIndex ] += toAdd;
-    remainder = digits[ addIndex ] < toAdd;
-    while( remainder )
+    for( bitsPerChar = 0; ( 1u << bitsPerChar ) < base; bitsPerChar++ );
+    if( value.isNegative() )
     {
-        addIndex++;
-        digits[ addIndex ] += remainder;
-        remainder = digits[ addIndex ] == (LI_Properties::digit::type)0;
+        resultStr.push_back( '-' );
     }
-
-    // remove leading zeros (due to oversizing)
-    removeLeadingZeros();
+    resultStr += powerOfTwoBaseString( value.limbs(), value.limbCount(), 
+                                       bitsPerChar, 0 );
+    return resultStr;
 }
 
 
-////////////// subtracting ///////////////
-
-// returns larger - smaller
-// requirement: first must be greater (or equal) than second
-//  - if not met, undefined behavior
-LargeInt subtractMagnitude( const LargeInt &larger, const LargeInt &smaller )
+/////////////////////////////// LI streaming ////////////////////////////////
+/* LargeIntCharacterSink
+collects characters in a fixed buffer and hands them to a write function a
+buffer at a time; after a failed write further characters are dropped
+(but still counted)
+*/
+class LargeIntCharacterSink
 {
-    LargeInt result = LargeInt();
-    unsigned int digitIndex;
-    unsigned int owe;
+public:
+    typedef bool (*WriteFunction)( void *target, const char *chars, size_t count );
 
-    // resize to larger's size (reduce later if leading zeros)
-    result.resize( larger.size );
+    LargeIntCharacterSink( WriteFunction write, void *target ) 
+        : write( write ), target( target ), used( 0 ), flushed( 0 ), failed( false ) {}
 
-    // initialize owe as 0
-    owe = 0;
+    void put( char character )
+    {
+        if( used == LI_Properties::conversion::STREAM_BUFFER_SIZE )
+        {
+            flush();
+        }
+        buffer[ used ] = character;
+        used++;
+    }
 
-    // iterate over digits small->large
-    for( digitIndex = 0; digitIndex < smaller.size; digitIndex++ )
+    void put( const char *chars, size_t count )
     {
-        result.digits[ digitIndex ] = larger.digits[ digitIndex ]
-                                       - smaller.digits[ digitIndex ]
-                                       - owe;
-        if( !owe )
+        for( ; count > 0; count--, chars++ )
         {
-            owe = smaller.digits[ digitIndex ] > larger.digits[ digitIndex ];
+            put( *chars );
         }
-        else
+    }
+
+    void put( char character, size_t count )
+    {
+        for( ; count > 0; count-- )
         {
-            owe = smaller.digits[ digitIndex ] >= larger.digits[ digitIndex ];
+            put( character );
         }
     }
 
-    // iterate over remaining digits
-    while( digitIndex < larger.size )
+    // hands over what is buffered, returns false if any write failed
+    bool flush()
     {
-        // set to larger - owe
-        result.digits[ digitIndex ] = larger.digits[ digitIndex ] - owe;
+        if( used > 0 && !failed )
+        {
+            failed = !write( target, buffer, used );
+        }
+        flushed += used;
+        used = 0;
+        return !failed;
+    }
 
-        // recalculate owe
-        owe &= larger.digits[ digitIndex ] == 0;
-        digitIndex++;
+    // characters put so far
+    size_t count() const
+    {
+        return flushed + used;
     }
 
-    // if still owe, invalid input: do not handle
+private:
+    WriteFunction write;
+    void *target;
+    char buffer[ LI_Properties::conversion::STREAM_BUFFER_SIZE ];
+    unsigned int used;
+    size_t flushed;
+    bool failed;
+};
 
-    // remove leading zeros
-    result.removeLeadingZeros();
+static bool writeToStream( void *target, const char *chars, size_t count )
+{
+    std::ostream &stream = *(std::ostream *)target;
 
-    return result;
+    stream.write( chars, (std::streamsize)count );
+    return !stream.fail();
 }
 
-LargeInt operator-( LargeInt &first, LargeInt &second )
+static bool writeToFile( void *target, const char *chars, size_t count )
 {
-    LargeInt result;
-    const LargeInt *smaller, *larger;
+    return fwrite( chars, 1, count, (FILE *)target ) == count;
+}
 
-    // check for diffferent sign
-    if( first.sign != second.sign )
-    {
-        // (second sign is flipped to have same sign)
-        // add magnitude of first/second
-        result = addMagnitude( first, second );
+static bool writeToDescriptor( void *target, const char *chars, size_t count )
+{
+    int fileDescriptor = *(int *)target;
+    long written;
 
-        // set result's sign to first's sign, return
-        result.sign = first.sign;
-        return result;
+    // writes may be partial or interrupted
+    while( count > 0 )
+    {
+#if defined( _WIN32 )
+        written = _write( fileDescriptor, chars, (unsigned int)count );
+#else
+        written = (long)write( fileDescriptor, chars, count );
+#endif
+        if( written < 0 )
+        {
+            if( errno == EINTR )
+            {
+                continue;
+            }
+            return false;
+        }
+        chars += written;
+        count -= (size_t)written;
     }
-    // otherwise, same sign
+    return true;
+}
 
-    // extract larger/smaller
-    if( first > second )
+/*
+splits like writeMagnitude, emitting the quotient's characters before the
+remainder's; only the parts still to be emitted are held (about twice the
+value's digits over all levels), never the whole string
+*/
+void LargeInt::streamMagnitude( LargeIntPowerCache &powerCache, 
+                                LargeIntCharacterSink &sink, unsigned int count ) const
+{
+    char leafChars[ LI_Properties::conversion::STRING_CHUNK_THRESHOLD * 
+                    LI_Properties::digit::SIZE ];
+    unsigned int level, lowerSize, leafCount, firstChar;
+    LargeInt divisionResult, remainder;
+
+    // small values: convert in place, then pad to count
+    if( size <= LI_Properties::conversion::STRING_CHUNK_THRESHOLD )
     {
-        larger = &first;
-        smaller = &second;
+        leafCount = characterBound( significantBits( digits, size ), 
+                                    powerCache.getBase() );
+        writeMagnitude( powerCache, leafChars, leafCount );
+        for( firstChar = 0; firstChar < leafCount && leafChars[ firstChar ] == '0'; 
+             firstChar++ );
+        if( count > leafCount - firstChar )
+        {
+            sink.put( '0', count - ( leafCount - firstChar ) );
+        }
+        sink.put( leafChars + firstChar, leafCount - firstChar );
+        return;
     }
-    else
+
+    // largest power with twice its size within this size
+    level = 0;
+    while( level + 1 < LI_Properties::conversion::MAX_POWER_LEVELS &&
+           2 * powerCache.power( level + 1 ).size <= size + 1 )
     {
-        larger = &second;
-        smaller = &first;
+        level++;
     }
-    
-    // subtract magnitude of smaller from larger
-    result = subtractMagnitude( *larger, *smaller );
+    lowerSize = powerCache.getChunkDigits() << level;
 
-    // set sign to larger, return
-    result.sign = larger->sign;
-    return result;
-}
+    divideLIMagnitude( *this, powerCache.power( level ), divisionResult, remainder );
 
+    // greater->smaller (the greater is never zero, so unpadded stays unpadded)
+    divisionResult.streamMagnitude( powerCache, sink, count == 0 ? 0 : count - lowerSize );
+    divisionResult = LargeInt(); // (released before the remainder splits)
+    remainder.streamMagnitude( powerCache, sink, lowerSize );
+}
 
-////////////// comparing ///////////////
-// returns positive if first is greater, 
-//    negative if second is greater, 
-//    zero if equal
-int spaceshipMagComp( const LargeInt &first, const LargeInt &second )
+void LargeInt::putMagnitude( LargeIntCharacterSink &sink, unsigned int base ) const
 {
-    int digitIndex;
+    // (throws for an invalid base, like toString)
+    LargeIntPowerCache &powerCache = sharedPowerCache( base );
+    unsigned int bitsPerChar, bitInd;
 
-    // case different size
-    if( first.size != second.size )
+    if( size == 0 )
     {
-        // return differnece in sizes
-        return first.size - second.size;
+        sink.put( '0' );
+        return;
     }
-    // otherwise, same size
 
-    // iterate over digits (most significant->least)
-    for( digitIndex = first.size - 1; digitIndex >= 0; digitIndex-- )
+    // power of two bases: read the bits of each character directly, most
+    // significant first
+    if( ( base & ( base - 1 ) ) == 0 )
     {
-        // end if differnece found
-        if( first.digits[ digitIndex ] != second.digits[ digitIndex ] )
+        for( bitsPerChar = 0; ( 1u << bitsPerChar ) < base; bitsPerChar++ );
+        for( bitInd = ( significantBits( digits, size ) + bitsPerChar - 1 ) / 
+                      bitsPerChar * bitsPerChar; bitInd > 0; bitInd -= bitsPerChar )
         {
-            // DO NOT RETURN SUBTRACT: (unsigned integers)
-            if( first.digits[ digitIndex ] > second.digits[ digitIndex ] )
-            {
-                return 1;
-            }
-            return -1;
+            sink.put( powerOfTwoBaseCharacter( digits, size, bitInd - bitsPerChar, 
+                                               bitsPerChar ) );
         }
+        return;
     }
 
-    // return no difference (all digits equal)
-    return 0; 
+    streamMagnitude( powerCache, sink, 0 );
 }
 
-int spaceshipComp( const LargeInt &first, const LargeInt &second )
+bool LargeInt::writeCharacters( LargeIntCharacterSink &sink, unsigned int base ) const
 {
-    // check signs are different
-    if( first.sign != second.sign )
+    if( sign && size != 0 )
     {
-        // first has negative sign
-        if( first.sign )
+        sink.put( '-' );
+    }
+    putMagnitude( sink, base );
+    return sink.flush();
+}
+
+bool LargeInt::writeTo( std::ostream &stream, unsigned int base ) const
+{
+    LargeIntCharacterSink sink( writeToStream, &stream );
+    return writeCharacters( sink, base );
+}
+
+bool LargeInt::writeTo( FILE *file, unsigned int base ) const
+{
+    LargeIntCharacterSink sink( writeToFile, file );
+    return writeCharacters( sink, base );
+}
+
+bool LargeInt::writeTo( int fileDescriptor, unsigned int base ) const
+{
+    LargeIntCharacterSink sink( writeToDescriptor, &fileDescriptor );
+    return writeCharacters( sink, base );
+}
+
+// as writeToStream, with letters in lowercase
+static bool writeLowercaseToStream( void *target, const char *chars, size_t count )
+{
+    char block[ 256 ];
+    size_t blockSize, index;
+
+    for( ; count > 0; chars += blockSize, count -= blockSize )
+    {
+        blockSize = min( count, sizeof( block ) );
+        for( index = 0; index < blockSize; index++ )
         {
-            return -1;
+            block[ index ] = (char)tolower( (unsigned char)chars[ index ] );
+        }
+        if( !writeToStream( target, block, blockSize ) )
+        {
+            return false;
         }
+    }
+    return true;
+}
+
+// the number of characters of value's magnitude in base: from the bit count
+// for power of two bases, otherwise down from characterBound while
+// base^(count - 1) is above the magnitude
+static unsigned int characterCount( const LargeIntView &value, unsigned int base )
+{
+    unsigned int bitCount = significantBits( value.limbs(), value.limbCount() );
+    unsigned int bitsPerChar, count;
+    LargeInt power;
+
+    if( bitCount == 0 )
+    {
         return 1;
     }
+    if( ( base & ( base - 1 ) ) == 0 )
+    {
+        for( bitsPerChar = 0; ( 1u << bitsPerChar ) < base; bitsPerChar++ );
+        return ( bitCount + bitsPerChar - 1 ) / bitsPerChar;
+    }
+    count = characterBound( bitCount, base );
+    power = toPower( LargeInt( base ), count - 1 );
+    while( count > 1 && spaceshipMagComp( value, power ) < 0 )
+    {
+        count--;
+        power = power / LargeInt( base );
+    }
+    return count;
+}
 
-    // set to reverse if negative
-    if( first.sign )
+/*
+the sign, base prefix and fill are put ahead of the digits, which are streamed
+as they are converted: fill after the digits (left) is counted as they go,
+fill before them (right, internal) needs their exact count up front
+*/
+std::ostream &operator<<( std::ostream &stream, const LargeInt &value )
+{
+    std::ios::fmtflags flags = stream.flags();
+    std::ios::fmtflags adjust = flags & std::ios::adjustfield;
+    unsigned int base = 10;
+    std::string prefix;
+    size_t width, padding = 0;
+
+    if( ( flags & std::ios::basefield ) == std::ios::hex )
     {
-        // return reversed magnitude comparison
-        return -spaceshipMagComp( first, second );
+        base = 16;
+    }
+    else if( ( flags & std::ios::basefield ) == std::ios::oct )
+    {
+        base = 8;
     }
 
-    // return normal comparison
-    return spaceshipMagComp( first, second );
+    std::ostream::sentry started( stream );
+    if( !started )
+    {
+        return stream;
+    }
+
+    // as for an int: the sign (with showpos), then 0x or 0 (with showbase,
+    // not for 0)
+    if( value.sign && value.size != 0 )
+    {
+        prefix = "-";
+    }
+    else if( flags & std::ios::showpos )
+    {
+        prefix = "+";
+    }
+    if( ( flags & std::ios::showbase ) && value.size != 0 && base != 10 )
+    {
+        prefix += base == 8 ? "0" : ( flags & std::ios::uppercase ) ? "0X" : "0x";
+    }
+    width = stream.width() > 0 ? (size_t)stream.width() : 0;
+    stream.width( 0 );
+    if( adjust != std::ios::left && width > prefix.size() + 1 )
+    {
+        padding = prefix.size() + characterCount( LargeIntView( value ), base );
+        padding = width > padding ? width - padding : 0;
+    }
+
+    // digits are converted in uppercase
+    LargeIntCharacterSink sink( base > 10 && !( flags & std::ios::uppercase ) ? 
+                                writeLowercaseToStream : writeToStream, &stream );
+    if( adjust == std::ios::internal )
+    {
+        sink.put( prefix.data(), prefix.size() );
+        sink.put( stream.fill(), padding );
+    }
+    else
+    {
+        sink.put( stream.fill(), padding );
+        sink.put( prefix.data(), prefix.size() );
+    }
+    value.putMagnitude( sink, base );
+    if( adjust == std::ios::left && width > sink.count() )
+    {
+        sink.put( stream.fill(), width - sink.count() );
+    }
+    if( !sink.flush() )
+    {
+        stream.setstate( std::ios::badbit );
+    }
+    return stream;
 }
 
 
+/////////////////////////////// LI streaming parser /////////////////////////
+// value of a character in any base up to 36 (36 if it is not one)
+static unsigned int characterValue( char character )
+{
+    if( character >= '0' && character <= '9' )
+    {
+        return character - '0';
+    }
+    if( character >= 'a' && character <= 'z' )
+    {
+        return character - 'a' + 10;
+    }
+    if( character >= 'A' && character <= 'Z' )
+    {
+        return character - 'A' + 10;
+    }
+    return 36;
+}
+
+static long readFromDescriptor( void *source, char *buffer, size_t capacity )
+{
+    int fileDescriptor = *(int *)source;
+    long count;
 
+    // retry interrupted reads
+    do
+    {
+#if defined( _WIN32 )
+        count = _read( fileDescriptor, buffer, (unsigned int)capacity );
+#else
+        count = (long)::read( fileDescriptor, buffer, capacity );
+#endif
+    } while( count < 0 && errno == EINTR );
+    return count;
+}
 
-bool operator<=( const LargeInt &first, const LargeInt &second )
+LargeIntParser::LargeIntParser( unsigned int base ) 
+    : base( base ), powerCache( sharedPowerCache( base ) ), partial( 0 ), 
+      partialDigits( 0 ), negative( false ), signAllowed( true ), 
+      numberEnded( false ), hasDigits( false )
 {
-    return spaceshipComp( first, second ) <= 0;
 }
 
-
-bool operator>=( const LargeInt &first, const LargeInt &second )
+size_t LargeIntParser::feed( const char *chars, size_t count )
 {
-    return spaceshipComp( first, second ) >= 0;
-}
+    unsigned int value;
+    size_t index;
 
+    for( index = 0; index < count && !numberEnded; index++ )
+    {
+        value = characterValue( chars[ index ] );
+        if( value >= base )
+        {
+            // a sign only leads the number
+            if( signAllowed && chars[ index ] == '-' )
+            {
+                negative = true;
+                signAllowed = false;
+                continue;
+            }
+            numberEnded = true;
+            break;
+        }
+        signAllowed = false;
+        hasDigits = true;
 
-bool operator>( const LargeInt &first, const LargeInt &second )
-{
-    return spaceshipComp( first, second ) > 0;
+        // each full chunk becomes a digit
+        partial = partial * base + value;
+        partialDigits++;
+        if( partialDigits == powerCache.getChunkDigits() )
+        {
+            chunks.resize( chunks.size + 1 );
+            chunks.digits[ chunks.size - 1 ] = partial;
+            partial = 0;
+            partialDigits = 0;
+        }
+    }
+    return index;
 }
 
-
-bool operator<( const LargeInt &first, const LargeInt &second )
+/*
+the characters in the stream's buffer are taken a span at a time and
+fed like a block of any other input; the characters after the end of the
+number are handed back, which cannot fail as they are still in the buffer
+(an unbuffered stream gives one character at a time)
+*/
+void LargeIntParser::read( std::istream &stream )
 {
-    return spaceshipComp( first, second ) < 0;
-}
+    char block[ LI_Properties::conversion::STREAM_BUFFER_SIZE ];
+    std::streambuf *buffer = stream.rdbuf();
+    std::streamsize available, count, used;
 
+    if( buffer == NULL )
+    {
+        stream.setstate( std::ios::badbit );
+        return;
+    }
 
-bool operator==( const LargeInt &first, const LargeInt &second )
-{
-    return spaceshipComp( first, second ) == 0;
+    while( !numberEnded )
+    {
+        // (refilling the buffer first, as an empty one reports what the
+        // source has left rather than what the buffer holds)
+        if( buffer->sgetc() == std::char_traits<char>::eof() )
+        {
+            stream.setstate( std::ios::eofbit );
+            break;
+        }
+        available = max( buffer->in_avail(), (std::streamsize)1 );
+        count = buffer->sgetn( block, min( available, (std::streamsize)sizeof( block ) ) );
+        used = (std::streamsize)feed( block, (size_t)count );
+        for( ; used < count; count-- )
+        {
+            if( buffer->sungetc() == std::char_traits<char>::eof() )
+            {
+                stream.setstate( std::ios::badbit );
+                break;
+            }
+        }
+    }
 }
 
-
-bool operator!=( const LargeInt &first, const LargeInt &second )
+bool LargeIntParser::read( int fileDescriptor )
 {
-    return spaceshipComp( first, second ) != 0;
+    return read( readFromDescriptor, &fileDescriptor );
 }
 
+bool LargeIntParser::read( ReadFunction readChars, void *source )
+{
+    char block[ LI_Properties::conversion::STREAM_BUFFER_SIZE ];
+    long count;
 
+    while( !numberEnded )
+    {
+        count = readChars( source, block, LI_Properties::conversion::STREAM_BUFFER_SIZE );
+        if( count < 0 )
+        {
+            return false;
+        }
+        if( count == 0 )
+        {
+            break;
+        }
+        feed( block, (size_t)count );
+    }
+    return true;
+}
 
-///////////// multiplication ///////////////
-void operator*=( LargeInt &one, LI_Properties::digit::type other )
+LargeInt LargeIntParser::finish()
 {
-    LI_Properties::digit::type low, high;
+    LI_Properties::digit::type partialBase = 1;
     unsigned int index;
-    unsigned int overflow = 0; // start with no overflow
+    LargeInt result;
 
-    // return '0' if multiplying by 0
-    if( other == 0 )
+    // full chunks (least significant first), then the partial chunk below them
+    std::reverse( chunks.digits, chunks.digits + chunks.size );
+    result = combineChunkArray( chunks.digits, chunks.size, powerCache );
+    if( partialDigits > 0 )
     {
-        one = LargeInt( 0 );
-        return;
+        for( index = 0; index < partialDigits; index++ )
+        {
+            partialBase *= base;
+        }
+        result *= partialBase;
+        result.addDigitAtIndex( partial, 0 );
     }
+    result.sign = negative && result.size != 0;
+
+    // start a new number
+    chunks = LargeInt();
+    partial = 0;
+    partialDigits = 0;
+    negative = false;
+    signAllowed = true;
+    numberEnded = false;
+    hasDigits = false;
+    return result;
+}
 
-    for( index = 0; index < one.size; index++ )
-    {
-        multiplyDigits( one.digits[ index ], other, low, high );
-        // add previous overflow and current low
-        one.digits[ index ] = overflow + low;
+std::istream &operator>>( std::istream &stream, LargeInt &value )
+{
+    unsigned int base = 10;
 
-        // store new overflow (accounting for remainder from previous)
-        overflow = high + ( one.digits[ index ] < low );
+    if( ( stream.flags() & std::ios::basefield ) == std::ios::hex )
+    {
+        base = 16;
+    }
+    else if( ( stream.flags() & std::ios::basefield ) == std::ios::oct )
+    {
+        base = 8;
     }
 
-    if( overflow )
+    // (skips whitespace unless the stream is set to noskipws)
+    std::istream::sentry started( stream );
+    if( !started )
     {
-        one.resize( one.size + 1 );
-        one.digits[ index ] = overflow;
+        return stream;
     }
 
-    // set sign if different signs
-    one.sign = one.sign != ( other < 0 );
+    LargeIntParser parser( base );
+    parser.read( stream );
+    if( parser.empty() )
+    {
+        stream.setstate( std::ios::failbit );
+        return stream;
+    }
+    value = parser.finish();
+    return stream;
 }
 
-void operator*=( LargeInt &first, const LargeInt &second )
+
+/////////////////////////////// LI binary format //////////////////////////////
+static long readFromStream( void *source, char *buffer, size_t capacity )
 {
-    first = first * second;
+    std::istream &stream = *(std::istream *)source;
+
+    stream.read( buffer, (std::streamsize)capacity );
+    if( stream.bad() )
+    {
+        return -1;
+    }
+    return (long)stream.gcount();
 }
 
-LargeInt operator*( const LargeInt &one, const LI_Properties::digit::type other )
+static long readFromFile( void *source, char *buffer, size_t capacity )
 {
-    LargeInt result = one;
-    result *= other;
+    size_t count = fread( buffer, 1, capacity, (FILE *)source );
 
-    return result;
+    if( count == 0 && ferror( (FILE *)source ) )
+    {
+        return -1;
+    }
+    return (long)count;
 }
 
-LargeInt operator*( const LargeInt &one, const LargeInt &other )
+// fills buffer, returns false if the input failed or ended first
+static bool readExactly( long (*readChars)( void *, char *, size_t ), void *source,
+                         char *buffer, size_t count )
 {
-    LargeInt result = LargeInt();
-
-    result = multiplyLIMagnitude( one, other );
+    long read;
 
+    while( count > 0 )
+    {
+        read = readChars( source, buffer, count );
+        if( read <= 0 )
+        {
+            return false;
+        }
+        buffer += read;
+        count -= (size_t)read;
+    }
+    return true;
+}
 
-    // (negative) sign if different signs
-    result.sign = one.sign != other.sign;
+static void encodeBinaryHeader( unsigned char *header, bool negative, 
+                                unsigned long long limbCount )
+{
+    unsigned int index;
 
-    return result;
+    for( index = 0; index < 4; index++ )
+    {
+        header[ index ] = (unsigned char)LI_Properties::binary::MAGIC[ index ];
+    }
+    header[ 4 ] = (unsigned char)( LI_Properties::binary::VERSION & 0xFF );
+    header[ 5 ] = (unsigned char)( LI_Properties::binary::VERSION >> 8 );
+    header[ 6 ] = (unsigned char)LI_Properties::digit::SIZE;
+    header[ 7 ] = negative ? 1 : 0;
+    for( index = 0; index < 8; index++ )
+    {
+        header[ 8 + index ] = (unsigned char)( limbCount >> ( 8 * index ) );
+    }
 }
 
-LargeInt multiplyLIMagnitude( const LargeInt &one, const LargeInt &other )
+// returns false if header is not in the format
+static bool decodeBinaryHeader( const unsigned char *header, bool &negative, 
+                                unsigned int &limbBits, unsigned long long &limbCount )
 {
-    // case size is one or zero (terminate recursion)
-        // case zero
-            // return 0
-        // case one
-            // digit multiplication
-    if( one.size <= 1 )
+    unsigned int index;
+
+    for( index = 0; index < 4; index++ )
     {
-        if( one.size == 0 )
+        if( header[ index ] != (unsigned char)LI_Properties::binary::MAGIC[ index ] )
         {
-            return LargeInt( 0 );
+            return false;
         }
-        return other * one.digits[ 0 ];
     }
-    if( other.size <= 1 )
+    if( ( header[ 4 ] | ( header[ 5 ] << 8 ) ) != LI_Properties::binary::VERSION )
     {
-        if( other.size == 0 )
-        {
-            return LargeInt( 0 );
-        }
-        return one * other.digits[ 0 ];
+        return false;
     }
-    if( one.size < 22 || other.size < 22 )
+    limbBits = header[ 6 ];
+    if( ( limbBits != 32 && limbBits != 64 ) || header[ 7 ] > 1 )
     {
-        return gradeschoolMagMult( one, other );
+        return false;
     }
+    negative = header[ 7 ] == 1;
+    limbCount = 0;
+    for( index = 0; index < 8; index++ )
+    {
+        limbCount |= (unsigned long long)header[ 8 + index ] << ( 8 * index );
+    }
+    return true;
+}
 
-    // otherwise, recurse by splitting
-    LargeInt oneLow, oneHigh, otherLow, otherHigh;
-    LargeInt lowProd, highProd, firstMixed, secondMixed;
-    unsigned int splitInd;
-
-    // identify split index: lowest half of both (cannot be 0 due to termination)
-    splitInd = min( one.size/2, other.size/2 );
-
-    // split based on the split index found
-    one.shallowSplit( oneLow, oneHigh, splitInd );
-    other.shallowSplit( otherLow, otherHigh, splitInd );
-
-    // multiply alternating permutations of high/low
-    lowProd = multiplyLIMagnitude( oneLow, otherLow );
-    highProd = multiplyLIMagnitude( oneHigh, otherHigh );
-    firstMixed = multiplyLIMagnitude( oneLow, otherHigh );
-    secondMixed = multiplyLIMagnitude( oneHigh, otherLow );
+bool LargeInt::saveBinary( bool (*writeChars)( void *, const char *, size_t ),
+                           void *target ) const
+{
+    unsigned char header[ LI_Properties::binary::HEADER_SIZE ];
 
-    // weight products according to splitInd
-    // low does not need to be shifted
-    highProd.digitShiftGreater( splitInd * 2 );
-    firstMixed.digitShiftGreater( splitInd );
-    secondMixed.digitShiftGreater( splitInd );
+    encodeBinaryHeader( header, sign && size != 0, size );
+    if( !writeChars( target, (const char *)header, sizeof( header ) ) )
+    {
+        return false;
+    }
 
-    // store original data in shallow copies
-    oneLow.digits = NULL;
-    otherLow.digits = NULL;
-    oneHigh.digits = NULL;
-    otherHigh.digits = NULL;
-    // return sum of products
-// TODO: do not use positive operator when sign has undefined value
-    return lowProd + highProd + firstMixed + secondMixed;
+#if defined( LI_LITTLE_ENDIAN )
+    // the digits are already laid out as saved
+    return size == 0 
+        || writeChars( target, (const char *)digits, 
+                       (size_t)size * sizeof( LI_Properties::digit::type ) );
+#else
+    const unsigned int digitBytes = sizeof( LI_Properties::digit::type );
+    unsigned char block[ 4096 ];
+    unsigned int index, byte, used = 0;
+
+    for( index = 0; index < size; index++ )
+    {
+        for( byte = 0; byte < digitBytes; byte++ )
+        {
+            block[ used++ ] = (unsigned char)( digits[ index ] >> ( 8 * byte ) );
+        }
+        if( used == sizeof( block ) || index + 1 == size )
+        {
+            if( !writeChars( target, (const char *)block, used ) )
+            {
+                return false;
+            }
+            used = 0;
+        }
+    }
+    return true;
+#endif
 }
 
-LargeInt gradeschoolMagMult( const LargeInt &one, const LargeInt &other )
+bool LargeInt::loadBinary( long (*readChars)( void *, char *, size_t ), void *source,
+                           long long available )
 {
-    LargeInt result = LargeInt( 0 );
-    const LargeInt *larger, *smaller;
-    unsigned int wkgSmallerInd;
-    LargeInt addValue;
+    const unsigned int digitBytes = sizeof( LI_Properties::digit::type );
+    unsigned char header[ LI_Properties::binary::HEADER_SIZE ];
+    unsigned char block[ 4096 ];
+    unsigned long long limbCount, byteCount, byteIndex, blockIndex, blockSize, loadBlock;
+    unsigned int limbBits;
+    bool negative;
+    LargeInt result;
 
-    if( one.size >= other.size )
+    if( !readExactly( readChars, source, (char *)header, sizeof( header ) )
+        || !decodeBinaryHeader( header, negative, limbBits, limbCount ) )
     {
-        larger = &one;
-        smaller = &other;
+        return false;
     }
-    else
+
+    // the digits must fit within resize's limit
+    if( limbCount > 0xFFFFFFFULL * digitBytes )
     {
-        larger = &other;
-        smaller = &one;
+        return false;
+    }
+    byteCount = limbCount * ( limbBits / 8 );
+    if( ( byteCount + digitBytes - 1 ) / digitBytes > 0xFFFFFFF )
+    {
+        return false;
     }
 
-    for( wkgSmallerInd = 0; wkgSmallerInd < smaller->size; wkgSmallerInd++ )
+    // nothing is allocated for limbs the input cannot hold
+    if( available >= 0 && 
+        (unsigned long long)available < LI_Properties::binary::HEADER_SIZE + byteCount )
     {
-// TODO: make more efficient
-        addValue = *larger * smaller->digits[ wkgSmallerInd ];
-        addValue.digitShiftGreater( wkgSmallerInd );
+        return false;
+    }
+    loadBlock = available >= 0 ? byteCount : LI_Properties::binary::LOAD_BLOCK_BYTES;
 
-        result = addMagnitude( result, addValue );
+#if defined( LI_LITTLE_ENDIAN )
+    if( limbBits == LI_Properties::digit::SIZE )
+    {
+        // read straight into the digits, growing them a block at a time
+        for( byteIndex = 0; byteIndex < byteCount; byteIndex += blockSize )
+        {
+            blockSize = min( byteCount - byteIndex, loadBlock );
+            result.resize( (unsigned int)( ( byteIndex + blockSize ) / digitBytes ) );
+            if( !readExactly( readChars, source, (char *)result.digits + byteIndex, 
+                              (size_t)blockSize ) )
+            {
+                return false;
+            }
+        }
+    }
+    else
+#endif
+    {
+        // assemble digits byte by byte (limbs of either width are little endian)
+        for( byteIndex = 0; byteIndex < byteCount; byteIndex += blockSize )
+        {
+            blockSize = min( byteCount - byteIndex, (unsigned long long)sizeof( block ) );
+            if( !readExactly( readChars, source, (char *)block, (size_t)blockSize ) )
+            {
+                return false;
+            }
+            result.resize( (unsigned int)( ( byteIndex + blockSize + digitBytes - 1 ) / 
+                                           digitBytes ) );
+            for( blockIndex = 0; blockIndex < blockSize; blockIndex++ )
+            {
+                result.digits[ ( byteIndex + blockIndex ) / digitBytes ] |= 
+                    (LI_Properties::digit::type)block[ blockIndex ] 
+                        << ( 8 * ( ( byteIndex + blockIndex ) % digitBytes ) );
+            }
+        }
     }
 
-    return result;
+    result.removeLeadingZeros();
+    result.sign = negative && result.size != 0;
+    *this = std::move( result );
+    return true;
 }
 
-
-
-
-
-
-/////////// division ////////////
-LargeInt operator/( const LargeInt &numerator, const LargeInt &denominator )
+bool LargeInt::save( std::ostream &stream ) const
 {
-    LargeInt divisionResult, remainder;
-    divideLIMagnitude( numerator, denominator, divisionResult, remainder );
-    divisionResult.sign = numerator.sign != denominator.sign;
-
-    return divisionResult;  // temp stub return
+    return saveBinary( writeToStream, &stream );
 }
 
-
-void divideLIMagnitude( const LargeInt &numerator, const LargeInt &denominator, 
-                            LargeInt &divisionResult, LargeInt &remainder )
+bool LargeInt::save( FILE *file ) const
 {
-    LargeInt wkgSubtractor;
-    LargeInt &wkgNumerator = remainder; // wkgNumerator is remainder at end
-    wkgNumerator = numerator; // deep copy of numerator
-// TODO: make more efficient
-    LargeInt wkgAdditive;
+    return saveBinary( writeToFile, file );
+}
 
-    // set division result to 0
-    divisionResult = LargeInt( 0 );
+bool LargeInt::save( int fileDescriptor ) const
+{
+    return saveBinary( writeToDescriptor, &fileDescriptor );
+}
 
-    // set wkgSubtractor to denominator
-    wkgSubtractor = denominator;
-    // shift greater such that 
-    //    wkgSubtractor's largest digit is one above numerator's largest digit
-    wkgSubtractor.digitShiftGreater( numerator.size - denominator.size + 1 );
-    // shift additive's bit equally
-    wkgAdditive = LargeInt( 1 );
-    wkgAdditive.digitShiftGreater( numerator.size - denominator.size + 1 );
+bool LargeInt::load( std::istream &stream )
+{
+    std::streampos start = stream.tellg();
+    long long available = -1;
 
-    // stop when subtractor is less than denominator
-    while( spaceshipMagComp( wkgSubtractor, denominator ) >= 0 )
+    // seekable streams know what is left
+    if( start != std::streampos( -1 ) )
     {
-        // subtract numerator is at least wkgSubtractor
-        if( spaceshipMagComp( wkgNumerator, wkgSubtractor ) >= 0 )
+        if( stream.seekg( 0, std::ios::end ) )
         {
-            // subtract wkgSubtractor from wkgNumerator
-            wkgNumerator = subtractMagnitude( wkgNumerator, wkgSubtractor );
-            divisionResult = addMagnitude( divisionResult, wkgAdditive );
-// TODO: make more efficient
+            available = (long long)( stream.tellg() - start );
+            stream.seekg( start );
+        }
+        else
+        {
+            stream.clear( stream.rdstate() & ~std::ios::failbit );
         }
-
-        // shfit wkgSubtractor less significant
-        wkgSubtractor >>= 1;
-        wkgAdditive >>= 1;
-// TODO: make more efficient
     }
-
-
+    return loadBinary( readFromStream, &stream, available );
 }
 
-
-/////////////////////////////////// LI display ////////////////////////////////
-std::string LargeInt::toStringBruteForce( unsigned int base, 
-                                          unsigned int forceSize ) const
+bool LargeInt::load( FILE *file )
 {
-    if( size == 0 )
+    long long available = -1;
+#if !defined( _WIN32 )
+    struct stat status;
+    long start = ftell( file );
+
+    // regular files know what is left (past the buffered position)
+    if( start >= 0 && fstat( fileno( file ), &status ) == 0 && S_ISREG( status.st_mode ) )
     {
-        return (std::string)"0";
+        available = (long long)status.st_size - start;
     }
+#endif
+    return loadBinary( readFromFile, file, available );
+}
 
-    LargeInt copy = *this;
-    LargeInt baseLI = LargeInt( base );
-    LargeInt divideResult, remainder;
-    std::string wkgStr;
+bool LargeInt::load( int fileDescriptor )
+{
+    long long available = -1;
+#if !defined( _WIN32 )
+    struct stat status;
+    off_t start = lseek( fileDescriptor, 0, SEEK_CUR );
 
-    while( copy.size != 0 )
+    if( start >= 0 && fstat( fileDescriptor, &status ) == 0 && S_ISREG( status.st_mode ) )
     {
-        divideLIMagnitude( copy, baseLI, divideResult, remainder );
-        wkgStr.push_back( intToChar( (int)remainder ) );
+        available = (long long)status.st_size - start;
+    }
+#endif
+    return loadBinary( readFromDescriptor, &fileDescriptor, available );
+}
 
-        copy = divideResult;
+bool LargeIntMapping::open( const char *path )
+{
+    close();
+#if defined( _WIN32 ) || !defined( LI_LITTLE_ENDIAN )
+    (void)path;
+    return false;
+#else
+    unsigned long long limbCount;
+    unsigned int limbBits;
+    bool negative;
+    struct stat status;
+    int fileDescriptor;
+    void *mapping;
+
+    fileDescriptor = ::open( path, O_RDONLY );
+    if( fileDescriptor < 0 )
+    {
+        return false;
     }
-    std::reverse(wkgStr.begin(), wkgStr.end());
-    if( forceSize > wkgStr.size() )
+    if( fstat( fileDescriptor, &status ) != 0 
+        || (unsigned long long)status.st_size < LI_Properties::binary::HEADER_SIZE )
     {
-        wkgStr = std::string( forceSize - wkgStr.size(), '0' ) + wkgStr;
+        ::close( fileDescriptor );
+        return false;
+    }
+    mapping = mmap( NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, 
+                    fileDescriptor, 0 );
+    // (the mapping outlives the descriptor)
+    ::close( fileDescriptor );
+    if( mapping == MAP_FAILED )
+    {
+        return false;
     }
-    return wkgStr;
-}
 
-std::string LargeInt::toString( unsigned int base ) const
-{
-    std::string resultStr;
-    if( sign )
+    // the limbs must be this build's and all present
+    if( !decodeBinaryHeader( (const unsigned char *)mapping, negative, limbBits, limbCount )
+        || limbBits != LI_Properties::digit::SIZE 
+        || limbCount > 0xFFFFFFF
+        || limbCount * sizeof( LI_Properties::digit::type ) 
+            > (unsigned long long)status.st_size - LI_Properties::binary::HEADER_SIZE )
     {
-        resultStr.push_back( '-' );
+        munmap( mapping, (size_t)status.st_size );
+        return false;
     }
-    resultStr += stringMagnitude( base, 0 );
 
-    return resultStr;
+    memory = mapping;
+    bytes = (size_t)status.st_size;
+    mapped = LargeIntView( (const LI_Limbs::limb *)
+                               ( (const char *)mapping + LI_Properties::binary::HEADER_SIZE ),
+                           (size_t)limbCount, negative );
+    return true;
+#endif
 }
 
-std::string LargeInt::stringMagnitude( unsigned int base, unsigned int forceSize ) const
+void LargeIntMapping::close()
 {
-    unsigned int baseDigits;
-    LargeInt divisionResult, remainder;
-    unsigned int smallerSize, largerSize;
-
-    // if reasonable size, terminate
-    if( size <= 1 )
+#if !defined( _WIN32 )
+    if( memory != NULL )
     {
-        // terminate recursion, returning last digit forced to size
-        if( size == 0 )
-        {
-            // return forced size zeros
-            return std::string( forceSize, '0' );
-        }
-        // not 0: brute force
-        return toStringBruteForce( base, forceSize );
+        munmap( memory, bytes );
     }
-
-    // estimate number of digits in base
-        // log<base>( <digit max> )
-    baseDigits = (unsigned int)
-                 (   
-                     (double)LI_Properties::digit::SIZE / 
-                     (double)std::log2( (double)base ) *
-                     (double)size
-                 ); // rounding up
-
-    // identify sizes of the large/small
-    smallerSize = baseDigits / 2;
-    largerSize = max( (int)forceSize - (int)smallerSize, 0 );
-
-    // identify divideValue
-    LargeInt divideValue = toPower( LargeInt( base ), smallerSize );
-
-    // divide self by 10^(num_digits/2), store divisionResult and remainder
-    divideLIMagnitude( *this, divideValue, divisionResult, remainder );
-
-    std::string greaterString = divisionResult.stringMagnitude( base, largerSize );
-    std::string smallerString = remainder.stringMagnitude( base, smallerSize );
-
-    // return greater->smaller
-    return greaterString + smallerString;
+#endif
+    memory = NULL;
+    bytes = 0;
+    mapped = LargeIntView();
 }
 
 
+/////////////////////////////// LI power cache ////////////////////////////////
+LargeIntPowerCache::LargeIntPowerCache( unsigned int base )
+{
+    this->base = base;
+    levelCount = 0;
+
+    // most characters that fit a digit, chunkBase = base^chunkDigits
+    chunkBase = base;
+    for( chunkDigits = 1; 
+         (LI_Properties::digit::doubleSize::type)chunkBase * base <= 
+         LI_Properties::digit::MAX;
+         chunkDigits++ )
+    {
+        chunkBase *= base;
+    }
+}
 
+const LargeInt &LargeIntPowerCache::power( unsigned int level )
+{
+    unsigned int computed;
 
+    // computed levels are only read
+    if( level < levelCount.load( std::memory_order_acquire ) )
+    {
+        return powers[ level ];
+    }
 
+    // square up from the last computed level (one thread at a time)
+    std::lock_guard<std::mutex> lock( growing );
+    computed = levelCount.load( std::memory_order_relaxed );
+    while( computed <= level )
+    {
+        if( computed == 0 )
+        {
+            powers[ 0 ] = LargeInt( chunkBase );
+        }
+        else
+        {
+            powers[ computed ] = square( powers[ computed - 1 ] );
+        }
+        computed++;
+        levelCount.store( computed, std::memory_order_release );
+    }
+    return powers[ level ];
+}
 
+void LargeIntPowerCache::precompute( unsigned int maxSize )
+{
+    unsigned int level = 0;
 
+    // the levels stringMagnitude and the string constructor can reach
+    while( level + 1 < LI_Properties::conversion::MAX_POWER_LEVELS &&
+           power( level ).size <= maxSize )
+    {
+        level++;
+    }
+    power( level );
+}
 
+LargeIntPowerCache &sharedPowerCache( unsigned int base )
+{
+    // one cache per base, created on first use and kept for the process
+    static LargeIntPowerCache *caches[ 37 ] = {};
+    static std::once_flag created[ 37 ];
 
-
-
-
+    if( base < 2 || base > 36 )
+    {
+        throw std::overflow_error( "invalid base " + std::to_string( base ) + 
+                                   " in sharedPowerCache\n" );
+    }
+    std::call_once( created[ base ], 
+                    [ base ]() { caches[ base ] = new LargeIntPowerCache( base ); } );
+    return *caches[ base ];
+}
 
 
 
@@ -1061,7 +5308,7 @@ char intToChar( int testInt )
     {
         return (char)testInt + '0';
     }
-    return testInt + 'A';
+    return (char)( testInt - 10 ) + 'A';
 }
 
 void multiplyDigits( LI_Properties::digit::type one, 
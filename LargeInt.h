@@ -11,11 +11,33 @@
 #include <stdexcept>
 #include <typeinfo>
 #include <algorithm> // std::reverse
+#include <utility> // std::move, std::swap
 #include <cmath> // log2
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uint64_t
+#include <atomic>
+#include <mutex>
 
 
 
 
+/* LI_DIGIT_BITS
+digit (limb) width, 32 or 64; define before including to choose. 64 bit
+digits need a 128 bit type for double size products, so they are the
+default only where the compiler has unsigned __int128
+*/
+#ifndef LI_DIGIT_BITS
+#if defined( __SIZEOF_INT128__ )
+#define LI_DIGIT_BITS 64
+#else
+#define LI_DIGIT_BITS 32
+#endif
+#endif
+
+#if LI_DIGIT_BITS != 32 && LI_DIGIT_BITS != 64
+#error "LI_DIGIT_BITS must be 32 or 64"
+#endif
+
 namespace LI_Properties
 {
 /*
@@ -32,23 +54,320 @@ namespace LI_Properties
 */
     namespace digit
     {
+#if LI_DIGIT_BITS == 64
+        typedef uint64_t type;
+#else
         typedef uint32_t type;
-        const uint32_t GREATEST_BIT_MASK = 0x7FFFFFFF;
-        const int SIZE = CHAR_BIT * sizeof( uint32_t );
-        const uint32_t MAX = 0xFFFFFFFF;
+#endif
+        const int SIZE = CHAR_BIT * sizeof( LI_Properties::digit::type );
+        const LI_Properties::digit::type MAX = ~(LI_Properties::digit::type)0;
+        const LI_Properties::digit::type GREATEST_BIT_MASK = MAX >> 1;
         const int HALF_SIZE = LI_Properties::digit::SIZE / 2;
-        const uint32_t LOWER_HALF_MASK = LI_Properties::digit::MAX >> 
-                                             HALF_SIZE;
+        const LI_Properties::digit::type LOWER_HALF_MASK = LI_Properties::digit::MAX >> 
+                                                           HALF_SIZE;
         namespace doubleSize
         {
+#if LI_DIGIT_BITS == 64
+            typedef unsigned __int128 type;
+#else
             typedef uint64_t type;
+#endif
+        }
+        namespace signedDoubleSize
+        {
+#if LI_DIGIT_BITS == 64
+            typedef __int128 type;
+#else
+            typedef int64_t type;
+#endif
         }
     }
 
     const int INITIAL_CAPACITY = 0;
+    // digits stored inside the LargeInt itself (above, on the heap)
+    const unsigned int INLINE_CAPACITY = 4;
+
+    namespace multiplication
+    {
+        // operands with fewer digits than this use gradeschool multiplication
+        const unsigned int KARATSUBA_THRESHOLD = 22;
+        // operands with at least this many digits use Toom-3 (above Karatsuba)
+        const unsigned int TOOM3_THRESHOLD = 150;
+        // operands with at least this many digits use Toom-4 (above Toom-3)
+        const unsigned int TOOM4_THRESHOLD = 400;
+        // operands with at least this many digits use the number theoretic
+        // transform (above Toom-4; the transform works on 32 bit words, so
+        // wide digits make Toom-4 competitive for longer)
+#if LI_DIGIT_BITS == 64
+        const unsigned int NTT_THRESHOLD = 4000;
+#else
+        const unsigned int NTT_THRESHOLD = 2000;
+#endif
+        // largest product (in digits) the transform can compute exactly,
+        // larger products are split by Toom-4 first (the transform works on
+        // 32 bit words, at most 2^26 of them)
+        const unsigned int NTT_MAX_SIZE = ( 1 << 26 ) / ( LI_DIGIT_BITS / 32 );
+        // with more than one thread (setLargeIntThreadCount), Toom-3/4 on
+        // operands with at least this many digits run their recursive
+        // products in parallel
+        const unsigned int PARALLEL_THRESHOLD = 1000;
+        // butterflies (or pointwise products) per parallel NTT task
+        const unsigned int NTT_PARALLEL_GRAIN = 1 << 14;
+    }
+
+    namespace memory
+    {
+        // smallest chunk (bytes) a scratch arena requests from the allocator
+        const size_t ARENA_CHUNK_BYTES = 1 << 20;
+        // chunks per arena (each at least double the previous)
+        const unsigned int ARENA_MAX_CHUNKS = 32;
+        // heap digit arrays of up to 2^(POOL_CLASSES - 1) digits are rounded
+        // to a power of two and kept in per-thread free lists when released
+        const unsigned int POOL_CLASSES = 21;
+        // released arrays kept per size class (above, returned to the allocator)
+        const unsigned int POOL_BLOCKS_PER_CLASS = 8;
+        // bytes of released arrays kept per thread, over all size classes
+        const size_t POOL_MAX_BYTES = 1 << 22;
+    }
+
+    namespace conversion
+    {
+        // strings with at most this many digit-sized chunks are combined one
+        // chunk at a time (above, divide and conquer)
+        const unsigned int PARSE_CHUNK_THRESHOLD = 32;
+        // values with at most this many digits are converted to strings one
+        // chunk at a time (above, divide and conquer)
+        const unsigned int STRING_CHUNK_THRESHOLD = 30;
+        // chunkBase^(2^level) for every level a LargeInt can need
+        const unsigned int MAX_POWER_LEVELS = 32;
+        // with more than one thread (setLargeIntThreadCount), values (or
+        // strings) of at least this many digits (or chunks) convert their
+        // two halves in parallel
+        const unsigned int PARALLEL_THRESHOLD = 2000;
+        // characters writeTo buffers before handing them to the output (and
+        // LargeIntParser reads from its input at a time)
+        const unsigned int STREAM_BUFFER_SIZE = 1 << 16;
+    }
+
+    namespace division
+    {
+        // quotients and denominators with at least this many digits use
+        // Burnikel-Ziegler recursive division (above Knuth's algorithm D)
+        const unsigned int BURNIKEL_ZIEGLER_THRESHOLD = 200;
+        // quotients and denominators with at least this many digits multiply
+        // by a Newton iteration reciprocal (above Burnikel-Ziegler)
+        const unsigned int NEWTON_THRESHOLD = 400000 / ( LI_DIGIT_BITS / 32 );
+    }
+
+    /* binary
+    the saved format, all little endian: a header of HEADER_SIZE bytes
+       bytes 0-3    MAGIC
+       bytes 4-5    VERSION
+       byte  6      limb bits (32 or 64)
+       byte  7      sign (1 if negative)
+       bytes 8-15   limb count
+    followed by the limbs (least significant first)
+    */
+    namespace binary
+    {
+        const char MAGIC[ 4 ] = { 'L', 'I', 'n', 't' };
+        const unsigned int VERSION = 1;
+        const unsigned int HEADER_SIZE = 16;
+        // from inputs of unknown size (pipes, sockets), load grows the value
+        // by at most this many bytes ahead of the limbs it has read, so a
+        // count the input does not hold fails early (inputs of known size
+        // are checked against the count and read in one block)
+        const unsigned int LOAD_BLOCK_BYTES = 1 << 20;
+    }
+}
+
+/* LI_Limbs
+the raw layer beneath LargeInt: functions over arrays of limbs (digits,
+lower is less significant) with explicit sizes, in the style of GMP's mpn
+functions, for use on caller owned buffers
+ - sizes are in limbs, and no function allocates except mul (scratch)
+ - unless noted, result may be the same array as an input, but must not
+   partly overlap one
+ - returned carries/borrows are single limbs
+*/
+namespace LI_Limbs
+{
+    typedef LI_Properties::digit::type limb;
+
+    // result = one + other (size limbs), returns the carry (0 or 1)
+    limb add_n( limb *result, const limb *one, const limb *other, size_t size );
+    // result = one + other (oneSize limbs, oneSize >= otherSize), returns the carry
+    limb add( limb *result, const limb *one, size_t oneSize, 
+              const limb *other, size_t otherSize );
+    // result = one - other (size limbs), returns the borrow (0 or 1)
+    limb sub_n( limb *result, const limb *one, const limb *other, size_t size );
+    // result = one - other (oneSize limbs, oneSize >= otherSize), returns the borrow
+    limb sub( limb *result, const limb *one, size_t oneSize, 
+              const limb *other, size_t otherSize );
+
+    // result = value * multiplier (size limbs), returns the high limb
+    limb mul_1( limb *result, const limb *value, size_t size, limb multiplier );
+    // result += value * multiplier (size limbs), returns the carry limb
+    // (result must not overlap value)
+    limb addmul_1( limb *result, const limb *value, size_t size, limb multiplier );
+    // result -= value * multiplier (size limbs), returns the borrow limb
+    // (result must not overlap value)
+    limb submul_1( limb *result, const limb *value, size_t size, limb multiplier );
+    // result = one * other (oneSize + otherSize limbs), with
+    // oneSize >= otherSize >= 1; result must not overlap either input
+    void mul( limb *result, const limb *one, size_t oneSize, 
+              const limb *other, size_t otherSize );
+
+    // result = value << shiftBits (size limbs, 0 < shiftBits < limb bits),
+    // returns the bits shifted out (in the low bits)
+    limb lshift( limb *result, const limb *value, size_t size, unsigned int shiftBits );
+    // result = value >> shiftBits (size limbs, 0 < shiftBits < limb bits),
+    // returns the bits shifted out (in the high bits)
+    limb rshift( limb *result, const limb *value, size_t size, unsigned int shiftBits );
+
+    // quotient = value / divisor (size limbs, divisor not 0), returns the remainder
+    limb divrem_1( limb *quotient, const limb *value, size_t size, limb divisor );
+
+    // compares one and other (size limbs), returning <0, 0 or >0
+    int cmp( const limb *one, const limb *other, size_t size );
 }
 
 class LargeInt;
+class LargeIntView;
+class LargeIntPowerCache;
+class LargeIntCharacterSink;
+template <class Expression> class LargeIntExpression;
+struct LargeIntExpressionTerm;
+
+
+/* LargeIntAllocator
+the memory source for all heap digit arrays and scratch arenas; the default
+uses operator new/delete
+ - must be set before any memory is taken from it (memory is returned to
+   the allocator that was current when it is released)
+*/
+struct LargeIntAllocator
+{
+    void *(*allocate)( size_t bytes );
+    void (*deallocate)( void *memory, size_t bytes );
+};
+
+void setLargeIntAllocator( const LargeIntAllocator &allocator );
+const LargeIntAllocator &getLargeIntAllocator();
+
+
+/* setLargeIntThreadCount
+opt-in parallel multiplication and string conversion: with more than one
+thread, large products and conversions spread over threadCount - 1 worker
+threads (a work stealing pool; a thread waiting on its tasks runs queued
+tasks too):
+ - Toom-3/4 run their recursive products as tasks
+ - the NTT runs its three convolutions, and the butterflies of each transform
+   stage, in parallel
+ - toString and the string constructor convert the two halves of each
+   split as tasks (the power cache is computed up front, so the tasks only
+   read it)
+every task writes only its own product, range or characters, so results do
+not depend on scheduling; a worker trims its arena (LargeIntArena::trim)
+whenever it runs out of tasks
+ - 1 (the default) multiplies on the calling thread only, 0 uses one thread
+   per hardware thread
+ - must not be called while a multiplication is running
+*/
+void setLargeIntThreadCount( unsigned int threadCount );
+unsigned int getLargeIntThreadCount();
+
+
+/* LargeIntArena
+per-thread memory for LargeInt operations (LargeIntArena::local()):
+ - scratch: bump allocation from chunks kept for the thread's lifetime;
+   allocations are released in stack order by returning to a mark, so a
+   top-level operation releases all its scratch at once (see
+   LargeIntScratchScope)
+ - pool: heap digit arrays of LargeInts are rounded to power of two sizes
+   and reused from per-size free lists, instead of going to the allocator
+   for every temporary (at most POOL_MAX_BYTES are kept)
+*/
+class LargeIntArena
+{
+public:
+    struct Mark
+    {
+        unsigned int chunk;
+        size_t used;
+    };
+
+    struct Stats
+    {
+        size_t scratchBytes; // scratch currently handed out
+        size_t peakScratchBytes; // most scratch handed out at once
+        size_t reservedScratchBytes; // chunk memory held for scratch
+        size_t pooledBytes; // released digit arrays kept for reuse
+    };
+
+    static LargeIntArena &local();
+
+    LargeIntArena();
+    ~LargeIntArena();
+
+    // scratch
+    void *allocateScratch( size_t bytes );
+    Mark mark() const;
+    void release( const Mark &toMark );
+
+    // pool, capacity is rounded up to the allocated size
+    LI_Properties::digit::type *allocateDigits( unsigned int &capacity );
+    void deallocateDigits( LI_Properties::digit::type *digits, 
+                           unsigned int capacity );
+
+    Stats getStats() const;
+    void resetPeak();
+    // returns unused scratch chunks and pooled arrays to the allocator
+    void trim();
+
+private:
+    struct Chunk
+    {
+        char *memory;
+        size_t capacity;
+        size_t used;
+    };
+
+    Chunk chunks[ LI_Properties::memory::ARENA_MAX_CHUNKS ];
+    unsigned int chunkCount;
+    unsigned int currentChunk;
+    size_t scratchBytes;
+    size_t peakScratchBytes;
+
+    LI_Properties::digit::type *pooled[ LI_Properties::memory::POOL_CLASSES ]
+                                      [ LI_Properties::memory::POOL_BLOCKS_PER_CLASS ];
+    unsigned int pooledCount[ LI_Properties::memory::POOL_CLASSES ];
+    size_t pooledBytes;
+
+    LargeIntArena( const LargeIntArena & );
+    void operator=( const LargeIntArena & );
+};
+
+
+/* LargeIntScratchScope
+scratch from the thread's arena, all released when the scope ends
+*/
+class LargeIntScratchScope
+{
+    LargeIntArena &arena;
+    LargeIntArena::Mark startMark;
+
+public:
+    LargeIntScratchScope() : arena( LargeIntArena::local() ), 
+                             startMark( arena.mark() ) {}
+    ~LargeIntScratchScope() { arena.release( startMark ); }
+
+    template <typename ElementType>
+    ElementType *allocate( size_t count )
+    {
+        return (ElementType *)arena.allocateScratch( count * sizeof( ElementType ) );
+    }
+};
 
 
 /*
@@ -67,42 +386,89 @@ private:
     unsigned int size;
     unsigned int capacity;
     bool sign; // boolean sign (does the value has a <negative> sign?)
+        // storage for small values, so they need no allocation
+    LI_Properties::digit::type inlineDigits[ LI_Properties::INLINE_CAPACITY ];
 
     // for generating initial memory for the data
     void initializeMemory( int initialMemory = 0 );
+    // sets the value to magnitude (negative if negative), for the integer
+    // constructors
+    void setInteger( unsigned long long magnitude, bool negative );
+    bool hasInlineDigits() const { return digits == inlineDigits; }
 
     //////////////////////////// memory management /////////////////////////////
     void resize( unsigned int newSize );
     void reallocate( unsigned int newCapacity );
     void removeLeadingZeros();
 
-    /* shallowSplit
-    Before Call:
-     - 'low' and 'high' must have memory allocated correctly (including base constrcutor)
-    After Call:
-     - 'low' and 'high' are a shallow copy, therefore the destructor cannot be called
-        - set digits to NULL for both to prevent the destructor from erroring
-        - low and high must be treated as constant after this function is called
-           - before modifying anything, set digits to NULL for the corresponding LI
-     - low begins at the start of this->digits, high begins at the splitInd of this->digits
-        - low ends at this->digits[ splitInd ] (exclusive)
-        - high ends at this->digits[ size ] (exclusive)
-
-    Requirements:
-     - splitInd must be no greater than the size of this
-    */
-    void shallowSplit( LargeInt &low, LargeInt &high, 
-                       unsigned int splitInd ) const;
+    // copy of digits[ start ] to digits[ start + count ] (exclusive, clamped
+    // to size), without leading zeros
+    LargeInt digitSlice( unsigned int start, unsigned int count ) const;
+
+    // adds magnitude of toAdd * <digit max + 1>^addIndex to magnitude in place
+    void addMagnitudeAtIndex( const LargeInt &toAdd, unsigned int addIndex );
+
+    // adds ( valueSign ? -1 : 1 ) * value[ 0 .. valueSize ) in place
+    void addSignedDigits( const LI_Properties::digit::type *value, 
+                          unsigned int valueSize, bool valueSign );
+
+    // adds ( negate ? -1 : 1 ) * one * other in place
+    void addProduct( const LargeInt &one, const LargeInt &other, bool negate );
+
+    // divides magnitude in place by divisor, returning the remainder
+    LI_Properties::digit::type divideByDigit( LI_Properties::digit::type divisor );
+
+    // sets magnitude from characters of a base 2^bitsPerChar string
+    // (most significant first)
+    void parsePowerOfTwoBase( std::string::const_iterator first, 
+                              std::string::const_iterator last, 
+                              unsigned int bitsPerChar );
+
+    // characters of the magnitude in base 2^bitsPerChar, most significant
+    // first, padded with zeros to forceSize
+    std::string stringPowerOfTwoBase( unsigned int bitsPerChar, 
+                                      unsigned int forceSize ) const;
+
+    // writes exactly count characters of the magnitude, padded with zeros,
+    // to first (count must be at least the magnitude's character count)
+    void writeMagnitude( LargeIntPowerCache &powerCache, char *first, 
+                         unsigned int count ) const;
+
+    // emits the characters of the magnitude to sink, most significant
+    // first, padded with zeros to exactly count (0: no padding)
+    void streamMagnitude( LargeIntPowerCache &powerCache, 
+                          LargeIntCharacterSink &sink, unsigned int count ) const;
+
+    // emits the magnitude in base to sink (without flushing it)
+    void putMagnitude( LargeIntCharacterSink &sink, unsigned int base ) const;
+
+    // emits the value in base to sink, returns false if the output failed
+    bool writeCharacters( LargeIntCharacterSink &sink, unsigned int base ) const;
+
+    // save and load through write and read functions (as in
+    // LargeIntCharacterSink and LargeIntParser); available is the number of
+    // bytes left in the input, or -1 if it is not known
+    bool saveBinary( bool (*writeChars)( void *target, const char *chars, size_t count ),
+                     void *target ) const;
+    bool loadBinary( long (*readChars)( void *source, char *buffer, size_t capacity ),
+                     void *source, long long available );
 
 
 public:
     ////////////////////////// constructors ///////////////////////////////////
     LargeInt();
     LargeInt( const LargeInt &source );
+    LargeInt( LargeInt &&source ) noexcept;
     explicit LargeInt( const int &source );
     explicit LargeInt( const LI_Properties::digit::type &source );
+    // every other integer type (unsigned int, long, long long, ...)
+    template <typename Integer, 
+              typename = typename std::enable_if<std::is_integral<Integer>::value>::type>
+    explicit LargeInt( const Integer &source );
     // large->small significance
     explicit LargeInt( const std::string &numericString, unsigned int base = 10 );
+    // copy of the digits a view refers to
+    explicit LargeInt( const LargeIntView &source );
     ~LargeInt();
 
     // data access
@@ -110,39 +476,555 @@ public:
     std::string toStringBruteForce( unsigned int base = 10, 
                                     unsigned int forceSize = 0 ) const;
     std::string toString( unsigned int base = 10 ) const;
+    std::string toString( LargeIntPowerCache &powerCache ) const;
     std::string stringMagnitude( unsigned int base, unsigned int forceSize ) const;
+    std::string stringMagnitude( LargeIntPowerCache &powerCache, 
+                                 unsigned int forceSize ) const;
+
+    // writes the value in base, like toString, without building the string:
+    // characters are emitted as the conversion produces them, most
+    // significant first, through a buffer of STREAM_BUFFER_SIZE characters
+    // (returns false if the output failed)
+    bool writeTo( std::ostream &stream, unsigned int base = 10 ) const;
+    bool writeTo( FILE *file, unsigned int base = 10 ) const;
+    bool writeTo( int fileDescriptor, unsigned int base = 10 ) const;
+
+    // binary format (LI_Properties::binary): save writes the header and the
+    // digits as they are; load replaces the value, converting limbs of the
+    // other width, and reads nothing past the value (both return false if
+    // the input or output failed, or the input is not in the format)
+    bool save( std::ostream &stream ) const;
+    bool save( FILE *file ) const;
+    bool save( int fileDescriptor ) const;
+    bool load( std::istream &stream );
+    bool load( FILE *file );
+    bool load( int fileDescriptor );
 
     // operators
     void addDigitAtIndex( LI_Properties::digit::type toAdd, unsigned int addIndex );
     void digitShiftLesser( int shiftAmount );
     void digitShiftGreater( int shiftAmount );
-    void operator=( const LargeInt &source );
+    LargeInt &operator=( const LargeInt &source );
+    LargeInt &operator=( LargeInt &&source ) noexcept;
     operator int() const;
 
+    // in place arithmetic, growing the digits only when needed
+    LargeInt &operator+=( const LargeIntView &other );
+    LargeInt &operator-=( const LargeIntView &other );
+    // this += one * other
+    void addmul( const LargeInt &one, const LargeInt &other );
+    // this -= one * other
+    void submul( const LargeInt &one, const LargeInt &other );
+    // evaluates a lazy expression (see LargeIntExpression) in one pass
+    template <class Expression>
+    LargeInt &operator=( const LargeIntExpression<Expression> &expression );
+
 
     // friends
     friend void operator <<= ( LargeInt &toShift, int shiftAmount );
     friend void operator >>= ( LargeInt &toShift, int shiftAmount );
-    friend LargeInt operator+( const LargeInt &one, const LargeInt &other );
-    friend LargeInt addMagnitude( const LargeInt &one, const LargeInt &other );
-    friend LargeInt subtractMagnitude( const LargeInt &one, const LargeInt &other );
-    friend int spaceshipMagComp( const LargeInt &first, const LargeInt &second );
-    friend int spaceshipComp( const LargeInt &first, const LargeInt &second );
-    friend LargeInt operator-( LargeInt &first, LargeInt &second );
-    friend void operator*=( LargeInt &one, unsigned int other );
+    friend LargeInt operator+( const LargeIntView &one, const LargeIntView &other );
+    friend LargeInt addMagnitude( const LargeIntView &one, const LargeIntView &other );
+    friend LargeInt subtractMagnitude( const LargeIntView &one, 
+                                       const LargeIntView &other );
+    friend LargeInt operator-( const LargeIntView &first, const LargeIntView &second );
+    friend void operator*=( LargeInt &one, LI_Properties::digit::type other );
     friend LargeInt operator*( const LargeInt &one, const LargeInt &other );
     friend LargeInt multiplyLIMagnitude( const LargeInt &one, const LargeInt &other );
+    friend LargeInt square( const LargeInt &value );
+    friend LargeInt squareLIMagnitude( const LargeInt &value );
     friend LargeInt operator/( const LargeInt &numerator, const LargeInt &denominator );
     friend void divideLIMagnitude( const LargeInt &numerator, 
                                    const LargeInt &denominator, 
                                    LargeInt &divisionResult, LargeInt &remainder );
+    friend void recursiveDivideMagnitude( const LargeInt &numerator, 
+                                          const LargeInt &denominator, 
+                                          LargeInt &divisionResult, 
+                                          LargeInt &remainder );
+    friend void divideTwoByOneBlocks( const LargeInt &numerator, 
+                                      const LargeInt &denominator,
+                                      unsigned int blockSize,
+                                      LargeInt &divisionResult, 
+                                      LargeInt &remainder );
+    friend void divideThreeByTwoBlocks( const LargeInt &numerator, 
+                                        const LargeInt &denominator,
+                                        unsigned int blockSize,
+                                        LargeInt &divisionResult, 
+                                        LargeInt &remainder );
+    friend LargeInt newtonReciprocal( const LargeInt &denominator, unsigned int cutoff );
+    friend void newtonDivideMagnitude( const LargeInt &numerator, 
+                                       const LargeInt &denominator, 
+                                       LargeInt &divisionResult, 
+                                       LargeInt &remainder,
+                                       unsigned int reciprocalCutoff );
     friend LargeInt gradeschoolMagMult( const LargeInt &one, const LargeInt &other );
+    friend LargeInt toom3MagMult( const LargeInt &one, const LargeInt &other );
+    friend LargeInt toom4MagMult( const LargeInt &one, const LargeInt &other );
+    friend LargeInt blockMagMult( const LargeInt &larger, const LargeInt &smaller );
+    friend class LargeIntPowerCache;
+    friend class LargeIntParser;
+    friend std::ostream &operator<<( std::ostream &stream, const LargeInt &value );
+    friend class LargeIntView;
+    friend LargeInt operator*( const LargeIntView &one, const LargeIntView &other );
+    template <unsigned int Bits, class OverflowPolicy> friend class FixedInt;
+    friend void LI_Limbs::mul( LI_Limbs::limb *result, 
+                               const LI_Limbs::limb *one, size_t oneSize, 
+                               const LI_Limbs::limb *other, size_t otherSize );
+    friend void evaluateExpressionTerms( LargeInt &result, 
+                                         LargeIntExpressionTerm *terms, 
+                                         unsigned int termCount );
+};
+
+template <typename Integer, typename>
+LargeInt::LargeInt( const Integer &source ) : LargeInt()
+{
+    // (negated as unsigned, so the most negative value has a magnitude)
+    bool negative = std::is_signed<Integer>::value && source < 0;
+    unsigned long long magnitude = (unsigned long long)source;
+
+    setInteger( negative ? 0 - magnitude : magnitude, negative );
+}
+
+
+
+/* LargeIntView
+a read-only, non-owning LargeInt: sign, digits and size, over a LargeInt or
+any external buffer of limbs (lower is less significant), with nothing
+copied
+ - every LargeInt converts to a view implicitly, so functions taking views
+   (comparisons, +, -, +=, -=, * and toString) take LargeInts too
+ - the buffer must outlive the view, and must not change while it is used
+ - leading zero limbs are ignored
+*/
+class LargeIntView
+{
+    const LI_Properties::digit::type *digits;
+    unsigned int size;
+    bool sign; // does the value have a <negative> sign?
+
+public:
+    LargeIntView() : digits( NULL ), size( 0 ), sign( false ) {}
+    LargeIntView( const LargeInt &value ) 
+        : digits( value.digits ), size( value.size ), sign( value.sign ) {}
+    LargeIntView( const LI_Limbs::limb *limbs, size_t count, bool negative = false );
+
+    const LI_Properties::digit::type *limbs() const { return digits; }
+    unsigned int limbCount() const { return size; }
+    bool isNegative() const { return sign; }
+
+    // magnitude of digits[ start ] to digits[ start + count ] (exclusive,
+    // clamped to size), without copying
+    LargeIntView slice( unsigned int start, unsigned int count ) const;
+
+    // friends
+    friend class LargeInt;
+    friend LargeInt operator+( const LargeIntView &one, const LargeIntView &other );
+    friend LargeInt addMagnitude( const LargeIntView &one, const LargeIntView &other );
+    friend LargeInt subtractMagnitude( const LargeIntView &one, 
+                                       const LargeIntView &other );
+    friend int spaceshipMagComp( const LargeIntView &first, const LargeIntView &second );
+    friend int spaceshipComp( const LargeIntView &first, const LargeIntView &second );
+    friend LargeInt operator-( const LargeIntView &first, const LargeIntView &second );
+    friend LargeInt operator*( const LargeIntView &one, const LargeIntView &other );
+};
+
+std::string toString( const LargeIntView &value, unsigned int base = 10 );
+
+
+
+/* LargeIntPowerCache
+powers of a base used to convert between strings and LargeInts, where a
+chunk is the most characters of the base that fit in one digit:
+   chunkBase = base^chunkDigits
+   power( level ) = chunkBase^(2^level)
+powers are computed by squaring on first use and kept for later calls, so
+converting many similarly sized values builds each power once; several
+threads may use one cache at once (computed powers are read without
+locking, new ones are added under a lock)
+
+sharedPowerCache( base ) is the process-wide cache used by toString, the
+string constructor, writeTo and LargeIntParser
+*/
+class LargeIntPowerCache
+{
+    unsigned int base;
+    unsigned int chunkDigits;
+    LI_Properties::digit::type chunkBase;
+    LargeInt powers[ LI_Properties::conversion::MAX_POWER_LEVELS ];
+    std::atomic<unsigned int> levelCount; // (powers below it never change)
+    std::mutex growing;
+
+public:
+    explicit LargeIntPowerCache( unsigned int base = 10 );
+
+    unsigned int getBase() const { return base; }
+    unsigned int getChunkDigits() const { return chunkDigits; }
+    LI_Properties::digit::type getChunkBase() const { return chunkBase; }
+
+    // chunkBase^(2^level)
+    const LargeInt &power( unsigned int level );
+
+    // computes every power needed to convert values of up to maxSize digits
+    void precompute( unsigned int maxSize );
 };
 
+LargeIntPowerCache &sharedPowerCache( unsigned int base );
+
+
+/* LargeIntParser
+reads a number from text that arrives in blocks (most significant first),
+without holding the text:
+   LargeIntParser parser( 10 );
+   parser.read( stream ); // or feed( chars, count ) block by block
+   LargeInt value = parser.finish();
+each chunk of chunkDigits characters is packed into one digit as it arrives,
+so the parser holds about the binary size of the result; finish() combines
+the chunks with the same divide and conquer as the string constructor
+
+the number is an optional '-' followed by characters of the base; it ends at
+the first other character (which is not consumed by feed or read( stream ))
+*/
+class LargeIntParser
+{
+public:
+    // bytes read into buffer (at most capacity), 0 at the end of the input,
+    // negative if reading failed
+    typedef long (*ReadFunction)( void *source, char *buffer, size_t capacity );
+
+    explicit LargeIntParser( unsigned int base = 10 );
+
+    // consumes characters of the number, returning how many (fewer than
+    // count once the number has ended)
+    size_t feed( const char *chars, size_t count );
+
+    // feed from an input until the number or the input ends:
+    //  - a stream is read through spans of its buffer and keeps the
+    //    character that ended the number; it gets eofbit at its end, and
+    //    badbit if the characters after the number cannot be put back
+    //  - a file descriptor or read function loses the rest of the block
+    //    that ended the number; returns false if reading failed
+    void read( std::istream &stream );
+    bool read( int fileDescriptor );
+    bool read( ReadFunction readChars, void *source );
+
+    // true once a character that is not part of the number was seen
+    bool ended() const { return numberEnded; }
+    // true while no digit has been consumed
+    bool empty() const { return !hasDigits; }
+
+    // value of the digits consumed (0 if none), starting a new number
+    LargeInt finish();
+
+private:
+    unsigned int base;
+    LargeIntPowerCache &powerCache;
+    LargeInt chunks; // full chunks as digits, most significant first
+    LI_Properties::digit::type partial; // value of the chunk being read
+    unsigned int partialDigits;
+    bool negative;
+    bool signAllowed;
+    bool numberEnded;
+    bool hasDigits;
+};
+
+
+/* LargeIntMapping
+a saved LargeInt (LargeInt::save) mapped read-only into memory, viewed
+where it lies: nothing is read until the view's limbs are used
+   LargeIntMapping mapping;
+   if( mapping.open( "value.bin" ) ) { use mapping.view() }
+ - open fails if the file cannot be mapped (POSIX systems only), is not in
+   the format, or holds limbs of another width or byte order than this
+   build's (LargeInt::load converts those)
+ - views must not be used after the mapping is closed or destroyed
+*/
+class LargeIntMapping
+{
+public:
+    LargeIntMapping() : memory( NULL ), bytes( 0 ) {}
+    ~LargeIntMapping() { close(); }
+
+    bool open( const char *path );
+    void close();
+    bool isOpen() const { return memory != NULL; }
+
+    // the mapped value (empty while closed)
+    LargeIntView view() const { return mapped; }
+
+private:
+    void *memory;
+    size_t bytes;
+    LargeIntView mapped;
+
+    LargeIntMapping( const LargeIntMapping & );
+    void operator=( const LargeIntMapping & );
+};
+
+
+
+
+/* LargeIntExpression
+lazy sums of LargeInts, started with lazy( value ):
+   result = lazy( a ) + b - ( lazy( c ) << 3 ) * 5;
+builds nothing until it is assigned (or converted) to a LargeInt, then
+every term is evaluated together in one pass over the digits, into one
+result sized from the operands (the result's own digits are reused when
+it is not also an operand)
+ - supports +, - (of LargeInts or expressions), << by a bit count and *
+   by a single digit; anything else converts to a LargeInt first
+ - operands are referenced, not copied, so an expression must be used
+   within the statement that builds it
+ - nested scalars are combined, and throw std::overflow_error if their
+   product does not fit in a digit
+*/
+
+// one flattened term: ( negative ? -1 : 1 ) * ( value << shiftBits ) * multiplier
+// (the remaining fields are working state for evaluateExpressionTerms)
+struct LargeIntExpressionTerm
+{
+    const LargeInt *value;
+    bool negative;
+    unsigned int shiftBits;
+    LI_Properties::digit::type multiplier;
+
+    const LI_Properties::digit::type *digits;
+    unsigned int start, end, size;
+    LI_Properties::digit::type previous, carry;
+};
+
+// sets result to the sum of the terms (result must not be any term's value)
+void evaluateExpressionTerms( LargeInt &result, LargeIntExpressionTerm *terms, 
+                              unsigned int termCount );
+
+// combines two scalars, throwing if the product overflows a digit
+LI_Properties::digit::type combineExpressionScalars( 
+                                    LI_Properties::digit::type one, 
+                                    LI_Properties::digit::type other );
+
+template <class Expression>
+class LargeIntExpression
+{
+public:
+    const Expression &self() const 
+    { 
+        return static_cast<const Expression &>( *this ); 
+    }
+
+    // flattens into terms, evaluates, and returns the value
+    operator LargeInt() const;
+
+    // true if value is one of the operands
+    bool refersTo( const LargeInt *value ) const
+    {
+        LargeIntExpressionTerm terms[ Expression::TERM_COUNT ];
+        unsigned int termInd;
+
+        self().collect( terms, false, 0, 1 );
+        for( termInd = 0; termInd < Expression::TERM_COUNT; termInd++ )
+        {
+            if( terms[ termInd ].value == value )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+class LargeIntLeaf : public LargeIntExpression<LargeIntLeaf>
+{
+    const LargeInt *value;
+
+public:
+    static const unsigned int TERM_COUNT = 1;
+
+    explicit LargeIntLeaf( const LargeInt &source ) : value( &source ) {}
+
+    void collect( LargeIntExpressionTerm *terms, bool negative, 
+                  unsigned int shiftBits, 
+                  LI_Properties::digit::type multiplier ) const
+    {
+        terms[ 0 ].value = value;
+        terms[ 0 ].negative = negative;
+        terms[ 0 ].shiftBits = shiftBits;
+        terms[ 0 ].multiplier = multiplier;
+    }
+};
+
+template <class Left, class Right, bool SUBTRACT>
+class LargeIntSum : public LargeIntExpression< LargeIntSum<Left, Right, SUBTRACT> >
+{
+    Left left;
+    Right right;
+
+public:
+    static const unsigned int TERM_COUNT = Left::TERM_COUNT + Right::TERM_COUNT;
+
+    LargeIntSum( const Left &leftSource, const Right &rightSource ) 
+        : left( leftSource ), right( rightSource ) {}
+
+    void collect( LargeIntExpressionTerm *terms, bool negative, 
+                  unsigned int shiftBits, 
+                  LI_Properties::digit::type multiplier ) const
+    {
+        left.collect( terms, negative, shiftBits, multiplier );
+        right.collect( terms + Left::TERM_COUNT, negative != SUBTRACT, 
+                       shiftBits, multiplier );
+    }
+};
+
+template <class Inner>
+class LargeIntShifted : public LargeIntExpression< LargeIntShifted<Inner> >
+{
+    Inner inner;
+    unsigned int bits;
+
+public:
+    static const unsigned int TERM_COUNT = Inner::TERM_COUNT;
+
+    LargeIntShifted( const Inner &source, unsigned int shiftBits ) 
+        : inner( source ), bits( shiftBits ) {}
+
+    void collect( LargeIntExpressionTerm *terms, bool negative, 
+                  unsigned int shiftBits, 
+                  LI_Properties::digit::type multiplier ) const
+    {
+        inner.collect( terms, negative, shiftBits + bits, multiplier );
+    }
+};
+
+template <class Inner>
+class LargeIntScaled : public LargeIntExpression< LargeIntScaled<Inner> >
+{
+    Inner inner;
+    LI_Properties::digit::type factor;
+
+public:
+    static const unsigned int TERM_COUNT = Inner::TERM_COUNT;
+
+    LargeIntScaled( const Inner &source, LI_Properties::digit::type scalar ) 
+        : inner( source ), factor( scalar ) {}
+
+    void collect( LargeIntExpressionTerm *terms, bool negative, 
+                  unsigned int shiftBits, 
+                  LI_Properties::digit::type multiplier ) const
+    {
+        inner.collect( terms, negative, shiftBits, 
+                       combineExpressionScalars( multiplier, factor ) );
+    }
+};
+
+inline LargeIntLeaf lazy( const LargeInt &value )
+{
+    return LargeIntLeaf( value );
+}
+
+template <class Expression>
+LargeIntExpression<Expression>::operator LargeInt() const
+{
+    LargeIntExpressionTerm terms[ Expression::TERM_COUNT ];
+    LargeInt result;
+
+    self().collect( terms, false, 0, 1 );
+    evaluateExpressionTerms( result, terms, Expression::TERM_COUNT );
+    return result;
+}
+
+template <class Expression>
+LargeInt &LargeInt::operator=( const LargeIntExpression<Expression> &expression )
+{
+    LargeIntExpressionTerm terms[ Expression::TERM_COUNT ];
+
+    // an operand would be overwritten while it is read: use a new result
+    if( expression.refersTo( this ) )
+    {
+        *this = (LargeInt)expression;
+        return *this;
+    }
+
+    expression.self().collect( terms, false, 0, 1 );
+    evaluateExpressionTerms( *this, terms, Expression::TERM_COUNT );
+    return *this;
+}
+
+// expression operators
+template <class Left, class Right>
+LargeIntSum<Left, Right, false> operator+( const LargeIntExpression<Left> &one,
+                                           const LargeIntExpression<Right> &other )
+{
+    return LargeIntSum<Left, Right, false>( one.self(), other.self() );
+}
+
+template <class Left>
+LargeIntSum<Left, LargeIntLeaf, false> operator+( const LargeIntExpression<Left> &one,
+                                                  const LargeInt &other )
+{
+    return LargeIntSum<Left, LargeIntLeaf, false>( one.self(), LargeIntLeaf( other ) );
+}
+
+template <class Right>
+LargeIntSum<LargeIntLeaf, Right, false> operator+( const LargeInt &one,
+                                                   const LargeIntExpression<Right> &other )
+{
+    return LargeIntSum<LargeIntLeaf, Right, false>( LargeIntLeaf( one ), other.self() );
+}
+
+template <class Left, class Right>
+LargeIntSum<Left, Right, true> operator-( const LargeIntExpression<Left> &one,
+                                          const LargeIntExpression<Right> &other )
+{
+    return LargeIntSum<Left, Right, true>( one.self(), other.self() );
+}
+
+template <class Left>
+LargeIntSum<Left, LargeIntLeaf, true> operator-( const LargeIntExpression<Left> &one,
+                                                 const LargeInt &other )
+{
+    return LargeIntSum<Left, LargeIntLeaf, true>( one.self(), LargeIntLeaf( other ) );
+}
+
+template <class Right>
+LargeIntSum<LargeIntLeaf, Right, true> operator-( const LargeInt &one,
+                                                  const LargeIntExpression<Right> &other )
+{
+    return LargeIntSum<LargeIntLeaf, Right, true>( LargeIntLeaf( one ), other.self() );
+}
+
+template <class Inner>
+LargeIntShifted<Inner> operator<<( const LargeIntExpression<Inner> &value, 
+                                   unsigned int shiftBits )
+{
+    return LargeIntShifted<Inner>( value.self(), shiftBits );
+}
+
+template <class Inner>
+LargeIntScaled<Inner> operator*( const LargeIntExpression<Inner> &value, 
+                                 LI_Properties::digit::type scalar )
+{
+    return LargeIntScaled<Inner>( value.self(), scalar );
+}
+
+template <class Inner>
+LargeIntScaled<Inner> operator*( LI_Properties::digit::type scalar, 
+                                 const LargeIntExpression<Inner> &value )
+{
+    return LargeIntScaled<Inner>( value.self(), scalar );
+}
+
 
 
 
 //////////////////////////// LargeInt Operators ///////////////////////////////
+//////////// output ///////////////
+// writes value like an int: in base 16 or 8 if the stream is set to hex or
+// oct (lowercase unless uppercase is set), with showpos, showbase, width and
+// fill; the characters are streamed as they are converted, and badbit is set
+// if the output fails
+std::ostream &operator<<( std::ostream &stream, const LargeInt &value );
+// reads value with LargeIntParser (after whitespace, in base 16 or 8 if the
+// stream is set to hex or oct); sets failbit if there are no digits
+std::istream &operator>>( std::istream &stream, LargeInt &value );
+
 //////////// shifting ///////////////
 void operator <<= ( LargeInt &toShift, int shiftAmount );
 void operator >>= ( LargeInt &toShift, int shiftAmount );
@@ -150,37 +1032,69 @@ LargeInt operator<<( LargeInt &toShift, int shiftVal );
 LargeInt operator>>( LargeInt &toShift, int shiftVal );
 
 //////////// addition ///////////////////
+// (the LargeInt overloads forward to the view ones: an exact match is
+// needed to win over the built in operators through operator int)
 LargeInt operator+( const LargeInt &one, const LargeInt &other );
-LargeInt addMagnitude( const LargeInt &one, const LargeInt &other );
+LargeInt operator+( const LargeIntView &one, const LargeIntView &other );
+LargeInt addMagnitude( const LargeIntView &one, const LargeIntView &other );
 
 /////////// subtraction /////////////////
-LargeInt subtractMagnitude( const LargeInt &one, const LargeInt &other );
-LargeInt operator-( LargeInt &first, LargeInt &second );
+LargeInt subtractMagnitude( const LargeIntView &one, const LargeIntView &other );
+LargeInt operator-( const LargeInt &first, const LargeInt &second );
+LargeInt operator-( const LargeIntView &first, const LargeIntView &second );
 
 
 /////////// multiplication //////////////
 LargeInt operator*( const LargeInt &one, const LI_Properties::digit::type other );
 LargeInt operator*( const LargeInt &one, const LargeInt &other );
+LargeInt operator*( const LargeIntView &one, const LargeIntView &other );
 void operator*=( LargeInt &one, LI_Properties::digit::type other );
 void operator*=( LargeInt &first, const LargeInt &second );
 LargeInt multiplyLI( const LargeInt &one, const LargeInt &other );
+LargeInt square( const LargeInt &value );
+LargeInt squareLIMagnitude( const LargeInt &value );
 LargeInt gradeschoolMagMult( const LargeInt &one, const LargeInt &other );
+LargeInt toom3MagMult( const LargeInt &one, const LargeInt &other );
+LargeInt toom4MagMult( const LargeInt &one, const LargeInt &other );
+LargeInt blockMagMult( const LargeInt &larger, const LargeInt &smaller );
 
 /////////// division //////////////
 LargeInt operator/( const LargeInt &numerator, const LargeInt &denominator );
+LargeInt operator/( const LargeIntView &numerator, const LargeIntView &denominator );
 void divideLIMagnitude( const LargeInt &numerator, const LargeInt &denominator, 
                               LargeInt &divisionResult, LargeInt &remainder );
+void recursiveDivideMagnitude( const LargeInt &numerator, 
+                               const LargeInt &denominator, 
+                               LargeInt &divisionResult, LargeInt &remainder );
+void divideTwoByOneBlocks( const LargeInt &numerator, const LargeInt &denominator,
+                           unsigned int blockSize,
+                           LargeInt &divisionResult, LargeInt &remainder );
+void divideThreeByTwoBlocks( const LargeInt &numerator, const LargeInt &denominator,
+                             unsigned int blockSize,
+                             LargeInt &divisionResult, LargeInt &remainder );
+LargeInt newtonReciprocal( const LargeInt &denominator, 
+                           unsigned int cutoff = LI_Properties::division::NEWTON_THRESHOLD );
+void newtonDivideMagnitude( const LargeInt &numerator, const LargeInt &denominator, 
+                            LargeInt &divisionResult, LargeInt &remainder,
+                            unsigned int reciprocalCutoff = 
+                                LI_Properties::division::NEWTON_THRESHOLD );
 
 
 ////////////// comparing ///////////////
-int spaceshipMagComp( const LargeInt &first, const LargeInt &second );
-int spaceshipComp( const LargeInt &first, const LargeInt &second );
+int spaceshipMagComp( const LargeIntView &first, const LargeIntView &second );
+int spaceshipComp( const LargeIntView &first, const LargeIntView &second );
 bool operator<=( const LargeInt &first, const LargeInt &second );
 bool operator>=( const LargeInt &first, const LargeInt &second );
 bool operator>( const LargeInt &first, const LargeInt &second );
 bool operator<( const LargeInt &first, const LargeInt &second );
 bool operator==( const LargeInt &first, const LargeInt &second );
 bool operator!=( const LargeInt &first, const LargeInt &second );
+bool operator<=( const LargeIntView &first, const LargeIntView &second );
+bool operator>=( const LargeIntView &first, const LargeIntView &second );
+bool operator>( const LargeIntView &first, const LargeIntView &second );
+bool operator<( const LargeIntView &first, const LargeIntView &second );
+bool operator==( const LargeIntView &first, const LargeIntView &second );
+bool operator!=( const LargeIntView &first, const LargeIntView &second );
 
 
 
@@ -253,12 +1167,6 @@ unsigned int charToInt( char charVal );
 char intToChar( int testInt );
 
 
-#endif // LARGE_INT_H
-
-
-
-
-
 template <typename BaseType>
 BaseType toPower( BaseType base, unsigned int power )
 {
@@ -275,13 +1183,11 @@ BaseType toPower( BaseType base, unsigned int power )
 
        if( power )
        {
+           // (multiplying by itself is detected as a square)
            baseMultiplier *= baseMultiplier;
        }
    }
    return result;
 }
 
-
-
-
-
+#endif // LARGE_INT_H
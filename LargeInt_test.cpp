@@ -1,12 +1,30 @@
 // compile:
-//   g++ -Wall LargeInt_test.cpp LargeInt.cpp -o outfile
+//   g++ -Wall -pthread LargeInt_test.cpp LargeInt.cpp -o outfile
 
 
 #include "LargeInt.h"
+#include "FixedInt.h"
 #include <iostream>
 #include <stdio.h>
+#include <iomanip>
+#include <fstream>
+#include <thread>
 
 
+// evaluated by the compiler
+static_assert( ( ( ( FixedInt<256>( 3 ) << 200 ) * FixedInt<256>( 5 ) ) >> 200 ) == 
+               FixedInt<256>( 15 ), "constexpr FixedInt" );
+
+// count digits of source starting at digit start, for operands of exact sizes
+static LargeInt digitSlice( LargeInt source, unsigned int start, unsigned int count )
+{
+    source >>= (int)( start * LI_Properties::digit::SIZE );
+    LargeInt high = source;
+    high >>= (int)( count * LI_Properties::digit::SIZE );
+    high <<= (int)( count * LI_Properties::digit::SIZE );
+    return source - high;
+}
+
 int main()
 {
 /*
@@ -148,6 +166,470 @@ int main()
     std::cout << myInt.toString() << "\n";
     std::cout << LargeInt( "1234567890987654321" ).toString() << "\n";
 */
+    std::cout << "-------------------- testing integer constructors ----------\n";
+    unsigned int unsignedTen = 10u;
+    if( LargeInt( unsignedTen ) != LargeInt( 10 ) || LargeInt( -10L ) != LargeInt( -10 ) ||
+        LargeInt( 18446744073709551615ULL ).toString() != (std::string)"18446744073709551615" ||
+        LargeInt( -9223372036854775807LL - 1 ).toString() != 
+        (std::string)"-9223372036854775808" )
+            {std::cout << "ERROR: integer constructor test\n";}
+
+    std::cout << "------------------------ testing digit width ---------------\n";
+    // the digit width (run with -DLI_DIGIT_BITS=32 too), and values past 64
+    // bits that come out the same in either width
+    LargeInt maxDigit( LI_Properties::digit::MAX );
+    std::string digitHex( LI_Properties::digit::SIZE / 4 - 1, 'F' );
+    if( LI_Properties::digit::SIZE != LI_DIGIT_BITS || 
+        sizeof( LI_Properties::digit::type ) * CHAR_BIT != LI_DIGIT_BITS ||
+        (LI_Properties::digit::type)( LI_Properties::digit::MAX + 1 ) != 0 ||
+        ( maxDigit * maxDigit ).toString( 16 ) != 
+        digitHex + "E" + std::string( digitHex.size(), '0' ) + "1" )
+            {std::cout << "ERROR: digit width test\n";}
+    LargeInt wideValue( 18446744073709551615ULL );
+    if( ( wideValue * wideValue ).toString() != 
+        (std::string)"340282366920938463426481119284349108225" ||
+        ( wideValue * wideValue + wideValue + wideValue ) / ( wideValue + LargeInt( 2 ) ) != 
+        wideValue )
+            {std::cout << "ERROR: wide value test\n";}
+
+    std::cout << "--------------------- testing inline digits ----------------\n";
+    // values growing past the inline digits (copied and moved), then shrinking
+    LargeInt inlineValue( 1 ), inlineCopy;
+    const unsigned int inlineLimit = LI_Properties::INLINE_CAPACITY + 2;
+    for( unsigned int digits = 1; digits <= inlineLimit; digits++ )
+    {
+        inlineValue <<= (int)LI_Properties::digit::SIZE;
+        inlineCopy = inlineValue - LargeInt( 1 );
+        LargeInt inlineMoved( std::move( inlineCopy ) );
+        if( inlineValue.toString( 16 ) != 
+            "1" + std::string( digits * LI_Properties::digit::SIZE / 4, '0' ) ||
+            inlineMoved.toString( 16 ) != 
+            std::string( digits * LI_Properties::digit::SIZE / 4, 'F' ) )
+                {std::cout << "ERROR: " << digits << " digit inline test\n";}
+    }
+    for( unsigned int digits = inlineLimit; digits > 0; digits-- )
+    {
+        inlineValue >>= (int)LI_Properties::digit::SIZE;
+    }
+    if( inlineValue != LargeInt( 1 ) )
+            {std::cout << "ERROR: inline shrinking test\n";}
+
+    std::cout << "------------------- testing multiplication tiers -----------\n";
+    // operands of size digits just above each tier's threshold, against
+    // gradeschool multiplication
+    LargeInt tierSource = toPower( LargeInt( 3 ), LI_Properties::digit::SIZE * 2 / 3 *
+                                   ( LI_Properties::multiplication::NTT_THRESHOLD + 4 ) );
+    const unsigned int toomSizes[ 2 ] = { LI_Properties::multiplication::TOOM3_THRESHOLD + 1,
+                                          LI_Properties::multiplication::TOOM4_THRESHOLD + 1 };
+    for( unsigned int size : toomSizes )
+    {
+        LargeInt tierOne = digitSlice( tierSource, 0, size );
+        LargeInt tierOther = digitSlice( tierSource, 2, size );
+        if( tierOne * tierOther != gradeschoolMagMult( tierOne, tierOther ) ||
+            square( tierOne ) != gradeschoolMagMult( tierOne, tierOne ) )
+                {std::cout << "ERROR: Toom " << size << " digit multiplication test\n";}
+    }
+    const unsigned int nttSize = LI_Properties::multiplication::NTT_THRESHOLD + 1;
+    LargeInt nttOne = digitSlice( tierSource, 0, nttSize );
+    LargeInt nttOther = digitSlice( tierSource, 2, nttSize );
+    if( nttOne * nttOther != gradeschoolMagMult( nttOne, nttOther ) ||
+        square( nttOne ) != gradeschoolMagMult( nttOne, nttOne ) )
+            {std::cout << "ERROR: NTT multiplication test\n";}
+    // gradeschool rows, against a single digit product per digit of other
+    const unsigned int rowsSize = LI_Properties::multiplication::KARATSUBA_THRESHOLD - 1;
+    LargeInt rowsOne = digitSlice( tierSource, 0, rowsSize ), rowsOther, rowsProduct;
+    for( unsigned int index = 0; index < rowsSize; index++ )
+    {
+        LI_Properties::digit::type rowDigit = LI_Properties::digit::MAX - 
+                                              index * index * 40503u;
+        LargeInt digitValue( rowDigit ), row = rowsOne * rowDigit;
+        digitValue <<= (int)( index * LI_Properties::digit::SIZE );
+        row <<= (int)( index * LI_Properties::digit::SIZE );
+        rowsOther = rowsOther + digitValue;
+        rowsProduct = rowsProduct + row;
+    }
+    if( gradeschoolMagMult( rowsOne, rowsOther ) != rowsProduct ||
+        rowsOne * rowsOther != rowsProduct )
+            {std::cout << "ERROR: gradeschool multiplication test\n";}
+
+    std::cout << "------------------------- testing square -------------------\n";
+    LargeInt squareBase = toPower( LargeInt( 7 ), 5000 );
+    LargeInt squareCopy = squareBase;
+    if( square( squareBase ) != squareBase * squareCopy )
+            {std::cout << "ERROR: square test\n";}
+    squareCopy *= squareCopy;
+    if( squareCopy != squareBase * LargeInt( squareBase ) )
+            {std::cout << "ERROR: aliased square test\n";}
+
+    std::cout << "------------------------ testing division ------------------\n";
+    // Knuth's algorithm D on numerators built from known quotients and
+    // remainders, with denominators that need no, little and much normalizing
+    LargeInt unit( 1 ), knownQuotient, knownRemainder;
+    for( int digits = 2; digits <= 6; digits++ )
+    {
+        const int bits = digits * LI_Properties::digit::SIZE;
+        LargeInt allOnes = ( unit << bits ) - unit;
+        LargeInt halfTop = ( unit << ( bits - 1 ) ) + unit;
+        LargeInt lowTop = ( unit << ( bits - LI_Properties::digit::SIZE ) ) + unit;
+        LargeInt quotient = ( unit << ( bits + 5 ) ) - unit;
+        for( const LargeInt &denominator : { allOnes, halfTop, lowTop } )
+        {
+            for( const LargeInt &remainder : { LargeInt( 0 ), denominator - unit } )
+            {
+                divideLIMagnitude( denominator * quotient + remainder, denominator, 
+                                   knownQuotient, knownRemainder );
+                if( knownQuotient != quotient || knownRemainder != remainder )
+                        {std::cout << "ERROR: Knuth " << digits << " digit division test\n";}
+            }
+        }
+    }
+    // quotient and denominator just below the Burnikel-Ziegler threshold use
+    // Knuth's algorithm D; the subquadratic tiers are run on them directly
+    const unsigned int ziegler = LI_Properties::division::BURNIKEL_ZIEGLER_THRESHOLD;
+    LargeInt divisionSource = square( square( squareBase ) );
+    LargeInt divisionNumerator = digitSlice( divisionSource, 0, 2 * ziegler - 3 );
+    LargeInt divisionDenominator = digitSlice( squareBase, 0, ziegler - 1 );
+    LargeInt knuthQuotient, knuthRemainder, tierQuotient, tierRemainder;
+    divideLIMagnitude( divisionNumerator, divisionDenominator, knuthQuotient, knuthRemainder );
+    if( knuthQuotient * divisionDenominator + knuthRemainder != divisionNumerator ||
+        knuthRemainder >= divisionDenominator )
+            {std::cout << "ERROR: Knuth division test\n";}
+    recursiveDivideMagnitude( divisionNumerator, divisionDenominator, 
+                              tierQuotient, tierRemainder );
+    if( tierQuotient != knuthQuotient || tierRemainder != knuthRemainder )
+            {std::cout << "ERROR: Burnikel-Ziegler division test\n";}
+    newtonDivideMagnitude( divisionNumerator, divisionDenominator, 
+                           tierQuotient, tierRemainder );
+    if( tierQuotient != knuthQuotient || tierRemainder != knuthRemainder )
+            {std::cout << "ERROR: Newton division test\n";}
+    // the Newton steps themselves, with the reciprocal's recursion cut off at
+    // 2 digits: odd sizes, and denominators with all ones, half and nearly
+    // empty top digits
+    for( unsigned int size : { 2u, 3u, 5u, 8u, 13u, 31u } )
+    {
+        const int bits = size * LI_Properties::digit::SIZE;
+        LargeInt onesTop = ( unit << bits ) - unit - digitSlice( tierSource, 0, size - 2 );
+        LargeInt halfTop = ( unit << ( bits - 1 ) ) + digitSlice( tierSource, 1, size - 1 );
+        LargeInt lowTop = ( unit << ( bits - LI_Properties::digit::SIZE ) ) + 
+                          digitSlice( tierSource, 2, size - 1 );
+        LargeInt exactReciprocal, knuthProduct;
+        for( const LargeInt &denominator : { onesTop, halfTop } )
+        {
+            divideLIMagnitude( unit << ( 2 * bits ), denominator, 
+                               exactReciprocal, knuthRemainder );
+            if( newtonReciprocal( denominator, 2 ) != exactReciprocal )
+                    {std::cout << "ERROR: " << size << " digit Newton reciprocal test\n";}
+        }
+        for( const LargeInt &denominator : { onesTop, halfTop, lowTop } )
+        {
+            knuthProduct = denominator * digitSlice( divisionSource, 5, 2 * size );
+            for( const LargeInt &numerator : { digitSlice( divisionSource, 0, 3 * size + 1 ),
+                                               knuthProduct + denominator - unit } )
+            {
+                divideLIMagnitude( numerator, denominator, knuthQuotient, knuthRemainder );
+                newtonDivideMagnitude( numerator, denominator, tierQuotient, tierRemainder, 2 );
+                if( tierQuotient != knuthQuotient || tierRemainder != knuthRemainder )
+                        {std::cout << "ERROR: " << size << " digit Newton step test\n";}
+            }
+        }
+    }
+    // just above the threshold, through operator/
+    divisionNumerator = digitSlice( divisionSource, 0, 3 * ziegler );
+    divisionDenominator = digitSlice( squareBase, 0, ziegler + 1 );
+    tierRemainder = divisionNumerator - divisionNumerator / divisionDenominator * 
+                                        divisionDenominator;
+    if( tierRemainder < LargeInt( 0 ) || tierRemainder >= divisionDenominator )
+            {std::cout << "ERROR: divided above threshold test\n";}
+
+    std::cout << "------------------------- testing moves --------------------\n";
+    // heap digits are taken, inline digits copied; sources are left as 0
+    LargeInt movedFrom = squareBase;
+    LargeInt movedTo( std::move( movedFrom ) );
+    if( movedTo != squareBase || movedFrom != LargeInt( 0 ) )
+            {std::cout << "ERROR: move construction test\n";}
+    movedFrom = LargeInt( -7 );
+    movedTo = std::move( movedFrom );
+    if( movedTo != LargeInt( -7 ) || movedFrom != LargeInt( 0 ) )
+            {std::cout << "ERROR: inline move assignment test\n";}
+    movedFrom = squareBase;
+    movedTo = std::move( movedFrom );
+    if( movedTo != squareBase || movedFrom != LargeInt( 0 ) )
+            {std::cout << "ERROR: move assignment test\n";}
+    // copies into a value with room reuse its digits
+    movedFrom = LargeInt( 5 );
+    movedTo = movedFrom;
+    movedFrom = movedTo - squareBase;
+    if( movedTo != LargeInt( 5 ) || movedFrom != LargeInt( 5 ) - squareBase )
+            {std::cout << "ERROR: copy assignment test\n";}
+
+    std::cout << "------------------------- testing arena --------------------\n";
+    LargeIntArena::local().resetPeak();
+    squareCopy = squareBase * ( squareBase + LargeInt( 1 ) );
+    if( LargeIntArena::local().getStats().peakScratchBytes == 0 ||
+        LargeIntArena::local().getStats().scratchBytes != 0 )
+            {std::cout << "ERROR: arena scratch test\n";}
+    if( LargeIntArena::local().getStats().pooledBytes > LI_Properties::memory::POOL_MAX_BYTES )
+            {std::cout << "ERROR: arena pool limit test\n";}
+
+    std::cout << "--------------------- testing in place ---------------------\n";
+    squareCopy = squareBase;
+    squareCopy += squareBase;
+    squareCopy -= LargeInt( 7 );
+    if( squareCopy != squareBase + squareBase - LargeInt( 7 ) )
+            {std::cout << "ERROR: in place add/subtract test\n";}
+    squareCopy.addmul( squareBase, LargeInt( 0 ) - squareBase );
+    squareCopy.submul( squareBase, LargeInt( 3 ) );
+    if( squareCopy != LargeInt( 0 ) - squareBase - LargeInt( 7 ) - square( squareBase ) )
+            {std::cout << "ERROR: addmul/submul test\n";}
+
+    std::cout << "--------------------- testing expressions ------------------\n";
+    squareCopy = lazy( squareBase ) * 3 - ( lazy( squareBase ) << 70 ) + LargeInt( 5 );
+    if( squareCopy != squareBase * LargeInt( 3 ) - ( squareBase << 70 ) + LargeInt( 5 ) )
+            {std::cout << "ERROR: expression test\n";}
+
+    std::cout << "------------------------- testing carries ------------------\n";
+    // carries and borrows through every digit, for lengths on both sides of
+    // the unrolled kernels' blocks of 4
+    for( int length = 1; length <= 9; length++ )
+    {
+        const int bits = length * LI_Properties::digit::SIZE;
+        const std::string allF( bits / 4, 'F' );
+        const std::string digitF( LI_Properties::digit::SIZE / 4 - 1, 'F' );
+        LargeInt carried = unit << bits;
+        LargeInt ones = carried - unit;
+        if( ones.toString( 16 ) != allF || ones + unit != carried ||
+            ( ones + ones ).toString( 16 ) != "1" + allF.substr( 1 ) + "E" ||
+            ( ones * LI_Properties::digit::MAX ).toString( 16 ) != 
+            digitF + "E" + allF.substr( digitF.size() + 1 ) + 
+            std::string( digitF.size(), '0' ) + "1" )
+                {std::cout << "ERROR: " << length << " digit carry chain test\n";}
+    }
+
+    std::cout << "------------------------ testing limb arrays ---------------\n";
+    LI_Limbs::limb limbsOne[ 2 ] = { LI_Properties::digit::MAX, LI_Properties::digit::MAX };
+    LI_Limbs::limb limbsOther[ 1 ] = { LI_Properties::digit::MAX };
+    LI_Limbs::limb limbsProduct[ 3 ];
+    LI_Limbs::mul( limbsProduct, limbsOne, 2, limbsOther, 1 );
+    if( limbsProduct[ 0 ] != 1 || limbsProduct[ 1 ] != LI_Properties::digit::MAX ||
+        limbsProduct[ 2 ] != LI_Properties::digit::MAX - 1 )
+            {std::cout << "ERROR: limb multiplication test\n";}
+    if( LI_Limbs::divrem_1( limbsProduct, limbsProduct, 3, LI_Properties::digit::MAX ) != 0 ||
+        LI_Limbs::cmp( limbsProduct, limbsOne, 2 ) != 0 || limbsProduct[ 2 ] != 0 )
+            {std::cout << "ERROR: limb division test\n";}
+    // carries and borrows through every limb, for lengths on both sides of
+    // the unrolled kernels' blocks of 4
+    for( unsigned int length = 1; length <= 9; length++ )
+    {
+        const LI_Limbs::limb all = LI_Properties::digit::MAX;
+        LI_Limbs::limb ones[ 9 ], unitLimbs[ 9 ] = { 1 }, chain[ 9 ];
+        bool chainsHold = true;
+        std::fill( ones, ones + 9, all );
+        chainsHold = chainsHold && LI_Limbs::add_n( chain, ones, unitLimbs, length ) == 1 &&
+                     std::count( chain, chain + length, 0 ) == (int)length;
+        chainsHold = chainsHold && LI_Limbs::sub_n( chain, chain, unitLimbs, length ) == 1 &&
+                     std::count( chain, chain + length, all ) == (int)length;
+        chainsHold = chainsHold && LI_Limbs::add_n( chain, chain, ones, length ) == 1 &&
+                     chain[ 0 ] == all - 1 && 
+                     std::count( chain + 1, chain + length, all ) == (int)length - 1;
+        std::fill( chain, chain + 9, all );
+        chainsHold = chainsHold && LI_Limbs::addmul_1( chain, ones, length, all ) == all &&
+                     chain[ 0 ] == 0 && 
+                     std::count( chain + 1, chain + length, all ) == (int)length - 1;
+        if( !chainsHold )
+                {std::cout << "ERROR: " << length << " limb carry chain test\n";}
+    }
+
+    std::cout << "------------------------- testing views --------------------\n";
+    LargeIntView limbsView( limbsOne, 2, true );
+    LargeInt limbsValue = LargeInt( 0 ) - 
+        LargeInt( std::string( LI_Properties::digit::SIZE / 2, 'F' ), 16 );
+    LargeInt limbsHigh( std::string( LI_Properties::digit::SIZE / 4, 'F' ), 16 );
+    if( limbsView != limbsValue || limbsView + limbsValue != limbsValue + limbsValue ||
+        limbsView * limbsView != square( limbsValue ) )
+            {std::cout << "ERROR: view arithmetic test\n";}
+    if( LargeInt( limbsView.slice( 1, 1 ) ) != limbsHigh ||
+        toString( limbsView, 16 ) != limbsValue.toString( 16 ) )
+            {std::cout << "ERROR: view slice test\n";}
+    LargeInt sliceSource( -5 );
+    sliceSource -= LargeIntView( sliceSource ).slice( 0, 100 );
+    if( sliceSource != LargeInt( -10 ) )
+            {std::cout << "ERROR: view self subtract test\n";}
+
+    std::cout << "--------------------- testing parallel operations ------------\n";
+    LargeInt parallelBase = toPower( LargeInt( 846 ), 30000 );
+    LargeInt serialProduct = parallelBase * ( parallelBase + LargeInt( 1 ) );
+    std::string serialString = parallelBase.toString();
+    LargeInt serialSquare = square( LargeInt( LargeIntView( parallelBase ).slice( 0, 2000 ) ) );
+    setLargeIntThreadCount( 4 );
+    if( parallelBase * ( parallelBase + LargeInt( 1 ) ) != serialProduct ||
+        square( LargeInt( LargeIntView( parallelBase ).slice( 0, 2000 ) ) ) != serialSquare )
+            {std::cout << "ERROR: parallel multiplication test\n";}
+    if( parallelBase.toString() != serialString || 
+        LargeInt( serialString ) != parallelBase )
+            {std::cout << "ERROR: parallel string conversion test\n";}
+    setLargeIntThreadCount( 1 );
+
+    std::cout << "------------------------ testing FixedInt ------------------\n";
+    LargeInt fixedSource = toPower( LargeInt( 7 ), 80 );
+    FixedInt<512> fixedBase( fixedSource );
+    if( (LargeInt)( fixedBase * fixedBase + fixedBase ) != 
+        square( fixedSource ) + fixedSource )
+            {std::cout << "ERROR: FixedInt arithmetic test\n";}
+    try
+    {
+        FixedInt<512, FixedIntChecked> checkedBase( fixedSource );
+        checkedBase <<= 512 - 1;
+        std::cout << "ERROR: FixedInt checked overflow test\n";
+    }
+    catch( std::overflow_error & ) {}
+
+    std::cout << "-------------------- testing string conversion -------------\n";
+    if( LargeInt( 0 ).toString() != (std::string)"0" )
+            {std::cout << "ERROR: zero string test\n";}
+    if( LargeInt( 255 ).toString( 16 ) != (std::string)"FF" )
+            {std::cout << "ERROR: hex string test\n";}
+    // strings over the chunk threshold (no chunk holds more characters than
+    // a digit has bits), against one character at a time
+    for( unsigned int base : { 7u, 10u } )
+    {
+        unsigned int length = LI_Properties::digit::SIZE * 
+                              ( LI_Properties::conversion::PARSE_CHUNK_THRESHOLD + 1 ) + 3;
+        std::string chunkedString;
+        LargeInt characterValue;
+        for( unsigned int index = 0; index < length; index++ )
+        {
+            unsigned int value = ( index * 7 + index / 3 + 1 ) % base;
+            chunkedString.push_back( (char)( '0' + value ) );
+            characterValue *= (LI_Properties::digit::type)base;
+            characterValue = characterValue + LargeInt( (int)value );
+        }
+        if( LargeInt( chunkedString, base ) != characterValue )
+                {std::cout << "ERROR: base " << base << " chunked parsing test\n";}
+    }
+    // cached powers (shared, and a cache reused for two sizes) against
+    // repeated division by the base
+    LargeIntPowerCache powersOfThree( 3 );
+    for( unsigned int size : { LI_Properties::conversion::STRING_CHUNK_THRESHOLD + 1, 600u } )
+    {
+        LargeInt converted = digitSlice( tierSource, 0, size );
+        if( converted.toString() != converted.toStringBruteForce() ||
+            converted.toString( powersOfThree ) != converted.toStringBruteForce( 3 ) )
+                {std::cout << "ERROR: " << size << " digit cached power string test\n";}
+    }
+    // threads growing the shared power cache at once
+    LargeInt threadedBase = toPower( LargeInt( 7 ), 20000 );
+    std::string threadedStrings[ 4 ];
+    std::thread converters[ 4 ];
+    for( unsigned int thread = 0; thread < 4; thread++ )
+    {
+        converters[ thread ] = std::thread( [ &, thread ]()
+            { threadedStrings[ thread ] = threadedBase.toString( 3 ); } );
+    }
+    for( unsigned int thread = 0; thread < 4; thread++ )
+    {
+        converters[ thread ].join();
+        if( LargeInt( threadedStrings[ thread ], 3 ) != threadedBase )
+                {std::cout << "ERROR: threaded string test\n";}
+    }
+    for( unsigned int base = 2; base <= 36; base++ )
+    {
+        if( LargeInt( squareBase.toString( base ), base ) != squareBase ||
+            LargeInt( ( LargeInt( 0 ) - squareBase ).toString( base ), base ) != 
+            LargeInt( 0 ) - squareBase )
+                {std::cout << "ERROR: base " << base << " round trip test\n";}
+    }
+    // character counts at the edges of powers of the base and of two
+    for( unsigned int base = 2; base <= 36; base++ )
+    {
+        for( unsigned int exponent : { 1u, 2u, 31u, 64u, 1001u } )
+        {
+            LargeInt basePower = toPower( LargeInt( base ), exponent );
+            LargeInt twoPower = toPower( LargeInt( 2 ), exponent );
+            if( ( basePower - LargeInt( 1 ) ).toString( base ).size() != exponent ||
+                basePower.toString( base ).size() != exponent + 1 ||
+                LargeInt( ( twoPower - LargeInt( 1 ) ).toString( base ), base ) != 
+                twoPower - LargeInt( 1 ) )
+                    {std::cout << "ERROR: base " << base << " character count test\n";}
+        }
+    }
+
+    std::ostringstream streamed;
+    streamed << parallelBase << ' ' << std::hex << std::uppercase 
+             << ( LargeInt( 0 ) - squareBase );
+    if( !parallelBase.writeTo( streamed, 7 ) ||
+        streamed.str() != serialString + " " + ( LargeInt( 0 ) - squareBase ).toString( 16 ) +
+                          parallelBase.toString( 7 ) )
+            {std::cout << "ERROR: stream output test\n";}
+    std::ostringstream formatted;
+    formatted << std::setw( 6 ) << LargeInt( -255 ) << '|' << std::hex << std::showpos 
+              << std::left << std::setfill( '*' ) << std::setw( 5 ) << LargeInt( 255 ) 
+              << '|' << std::noshowpos << LargeInt( 255 ) << std::setw( 3 ) << LargeInt( 1 );
+    if( formatted.str() != "  -255|+ff**|ff1**" )
+            {std::cout << "ERROR: formatted stream output test\n";}
+    formatted.str( "" );
+    formatted << std::showbase << std::internal << std::setw( 8 ) << LargeInt( -255 ) << '|' 
+              << std::uppercase << LargeInt( 255 ) << '|' << std::oct << LargeInt( 8 ) << '|' 
+              << LargeInt( 0 ) << std::dec << std::setfill( ' ' ) << std::setw( 3 ) 
+              << LargeInt( 0 );
+    if( formatted.str() != "-0x***ff|0XFF|010|0  0" )
+            {std::cout << "ERROR: showbase stream output test\n";}
+    // padding around digits that are streamed as they are converted
+    const int serialWidth = (int)serialString.size();
+    formatted.str( "" );
+    formatted << std::noshowbase << std::right << std::setfill( '#' ) 
+              << std::setw( serialWidth + 2 ) << parallelBase << '|' 
+              << std::left << std::setw( serialWidth + 3 ) << parallelBase;
+    if( formatted.str() != "##" + serialString + "|" + serialString + "###" )
+            {std::cout << "ERROR: padded stream output test\n";}
+    std::ofstream fullFile( "/dev/full" );
+    if( fullFile.is_open() && !( fullFile << parallelBase ).bad() )
+            {std::cout << "ERROR: failed stream output test\n";}
+    std::istringstream parsedStream( " " + serialString + " -ff," );
+    LargeInt parsedOne, parsedOther;
+    parsedStream >> parsedOne >> std::hex >> parsedOther;
+    if( !parsedStream || parsedOne != parallelBase || parsedOther != LargeInt( -255 ) ||
+        parsedStream.peek() != ',' )
+            {std::cout << "ERROR: stream input test\n";}
+    // a file read through spans of its buffer keeps everything after the number
+    std::ofstream parsedOut( "LargeInt_test.txt" );
+    parsedOut << serialString << ' ' << serialString << ",rest";
+    parsedOut.close();
+    std::ifstream parsedFile( "LargeInt_test.txt" );
+    std::string parsedRest;
+    parsedFile >> parsedOne >> parsedOther >> parsedRest;
+    if( !parsedFile || parsedOne != parallelBase || parsedOther != parallelBase || 
+        parsedRest != ",rest" )
+            {std::cout << "ERROR: file stream input test\n";}
+    parsedFile.close();
+    remove( "LargeInt_test.txt" );
+
+    std::cout << "--------------------- testing binary format ----------------\n";
+    std::stringstream saved;
+    LargeInt loadedOne, loadedOther( 7 );
+    if( !parallelBase.save( saved ) || !( LargeInt( 0 ) - squareBase ).save( saved ) ||
+        !loadedOne.load( saved ) || !loadedOther.load( saved ) ||
+        loadedOne != parallelBase || loadedOther != LargeInt( 0 ) - squareBase ||
+        loadedOther.load( saved ) )
+            {std::cout << "ERROR: binary round trip test\n";}
+    // a limb count the input does not hold is rejected before it is allocated
+    std::string corrupted = saved.str();
+    corrupted[ 11 ] = 0x0F;
+    std::istringstream corruptedStream( corrupted );
+    if( loadedOne.load( corruptedStream ) || loadedOne != parallelBase )
+            {std::cout << "ERROR: binary limb count test\n";}
+    FILE *savedFile = fopen( "LargeInt_test.bin", "wb" );
+    if( savedFile != NULL )
+    {
+        bool savedAll = ( LargeInt( 0 ) - parallelBase ).save( savedFile );
+        fclose( savedFile );
+        LargeIntMapping mapping;
+        if( !savedAll || !mapping.open( "LargeInt_test.bin" ) ||
+            mapping.view() != LargeIntView( LargeInt( 0 ) - parallelBase ) )
+                {std::cout << "ERROR: mapped binary test\n";}
+        mapping.close();
+        remove( "LargeInt_test.bin" );
+    }
+
     std::cout << "------------------------- testing power --------------------\n";
 /*
     myInt = toPower( LargeInt( 123 ), 10 );